@@ -0,0 +1,126 @@
+#ifndef __CPULOAD_H__
+#define __CPULOAD_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/UART.h>
+
+//
+//	CPU load monitor. Handlers bracket their work with
+//	CpuLoad_begin()/CpuLoad_end(), the load is the time they took in
+//	the period. Kernel code outside the brackets counts as idle.
+//
+//	Handlers are timed in CPU cycles (Cycles_now()), a run of a few
+//	microseconds counts in full. The period and the busy stretches
+//	between Idle hook runs (CpuLoad_idle()) come from the AON RTC,
+//	which keeps counting in standby while the cycle counter stops.
+//
+//	Every CPULOAD_REPORT_MS a task prints the load of the period over
+//	UART: the total and per thread type, the handler that took most,
+//	its longest run, and the longest stretch the idle loop didn't run.
+//	Other modules add their telemetry lines after it, or write to the
+//	UART through CpuLoad_write().
+//
+//	Build with CPULOAD=0 to leave it out, the brackets compile to
+//	nothing.
+//
+#ifndef CPULOAD
+#define CPULOAD									1
+#endif
+
+#define CPULOAD_REPORT_MS				10000
+#define CPULOAD_MAX_REPORTS			4
+#define CPULOAD_LINE_SIZE				160
+
+//
+//	Thread types.
+//
+#define CPULOAD_HWI							0
+#define CPULOAD_SWI							1
+#define CPULOAD_TASK						2
+#define CPULOAD_NUM_TYPES				3
+
+typedef struct CpuLoad_Handler
+{
+	const char* name;
+	uint8_t     type;
+
+	//
+	//	Cycles taken in the current period, less the cycles handlers
+	//	that preempted it took, and the longest run. The handler is
+	//	linked in on its first run.
+	//
+	uint32_t    time;
+	uint32_t    run;
+	uint32_t    maxRun;
+	Bool        linked;
+
+	struct CpuLoad_Handler* outer;
+	struct CpuLoad_Handler* next;
+} CpuLoad_Handler;
+
+//
+//	Formats a telemetry line, newline included, into a buffer of
+//	CPULOAD_LINE_SIZE and returns its length.
+//
+typedef Int (*CpuLoad_ReportFxn)(char* line);
+
+#if CPULOAD
+
+//
+//	Define a handler's accounting, at file scope.
+//
+#define CPULOAD_HANDLER(var, name, type)	static CpuLoad_Handler var = { (name), (type) }
+
+//
+//	Start the report task, writing to the given UART. Call once
+//	before BIOS_start().
+//
+void CpuLoad_init(UART_Handle uart);
+
+//
+//	Bracket a handler run, callable from any context. Runs nest the
+//	way the handlers preempt each other.
+//
+void CpuLoad_begin(CpuLoad_Handler* handler);
+void CpuLoad_end(CpuLoad_Handler* handler);
+
+//
+//	Send a line after every report, up to CPULOAD_MAX_REPORTS. Call
+//	before BIOS_start().
+//
+void CpuLoad_addReport(CpuLoad_ReportFxn fxn);
+
+//
+//	Write to the report UART from a task, one writer at a time: the
+//	UART driver fails a write while another is in progress.
+//
+Int CpuLoad_write(UART_Handle uart, const void* buffer, size_t size);
+
+#else
+
+#define CPULOAD_HANDLER(var, name, type)
+#define CpuLoad_init(uart)
+#define CpuLoad_begin(handler)
+#define CpuLoad_end(handler)
+#define CpuLoad_addReport(fxn)
+#define CpuLoad_write(uart, buffer, size)	UART_write((uart), (buffer), (size))
+
+#endif
+
+//
+//	Idle hook, Idle.addFunc("&CpuLoad_idle") in the .cfg. Empty
+//	without CPULOAD.
+//
+void CpuLoad_idle(void);
+
+#endif
@@ -0,0 +1,26 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include <inc/hw_types.h>
+#include <inc/hw_cpu_dwt.h>
+#include <inc/hw_cpu_scs.h>
+
+#include "Cycles.h"
+
+void Cycles_init(void)
+{
+	//
+	//	The DWT only runs with trace enabled in the debug monitor
+	//	control register.
+	//
+	HWREG(CPU_SCS_BASE + CPU_SCS_O_DEMCR)  |= CPU_SCS_DEMCR_TRCENA;
+	HWREG(CPU_DWT_BASE + CPU_DWT_O_CYCCNT)  = 0;
+	HWREG(CPU_DWT_BASE + CPU_DWT_O_CTRL)   |= CPU_DWT_CTRL_CYCCNTENA;
+}
+
+uint32_t Cycles_now(void)
+{
+	return HWREG(CPU_DWT_BASE + CPU_DWT_O_CYCCNT);
+}
@@ -0,0 +1,180 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include "DHT11.h"
+#include "DHT11Multi.h"
+#include "HRTimer.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+
+static PIN_Config DHT11Multi_pinTable[DHT11_MULTI_MAX_SENSORS + 1];
+static PIN_State  DHT11Multi_state;
+static PIN_Handle DHT11Multi_handle;
+
+static PIN_Id   DHT11Multi_pins[DHT11_MULTI_MAX_SENSORS];
+static uint8_t  DHT11Multi_numSensors;
+static uint32_t DHT11Multi_mask;
+
+static uint8_t  DHT11Multi_timeoutPhases[DHT11_MULTI_MAX_SENSORS];
+
+//
+//	Decoder state, too large for the calling task's stack.
+//
+static DHT11_Lanes DHT11Multi_lanes;
+
+CPULOAD_HANDLER(DHT11Multi_receiveLoad, "dht11 multi receive", CPULOAD_TASK);
+PROFILE_REGION(DHT11Multi_receiveProfile, "DHT11Multi_receive");
+
+void DHT11Multi_init(const PIN_Id* pins, uint8_t numSensors)
+{
+	uint8_t i = 0;
+
+	if (numSensors > DHT11_MULTI_MAX_SENSORS) System_abort("Too many DHT11 sensors\n");
+
+	for (i = 0; i < numSensors; i++)
+	{
+		DHT11Multi_pins[i]     = pins[i];
+		DHT11Multi_pinTable[i] = pins[i] | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_OPENDRAIN | PIN_INPUT_EN | PIN_NOPULL;
+		DHT11Multi_mask       |= (uint32_t)1 << pins[i];
+	}
+
+	DHT11Multi_pinTable[numSensors] = PIN_TERMINATE;
+	DHT11Multi_numSensors = numSensors;
+
+	DHT11Multi_handle = PIN_open(&DHT11Multi_state, DHT11Multi_pinTable);
+	if (!DHT11Multi_handle) System_abort("Error allocating pins - DHT11Multi_pinTable\n");
+
+	//
+	//	Every sensor counts into the driver's counters.
+	//
+	DHT11_addReport();
+}
+
+//
+//	Release the lines and sample the port until every sensor in mask
+//	sent its frame, or the frame timeout. Swis and Hwis stay
+//	enabled, as for the single sensor's poll: the widths come from
+//	the timestamps of the samples, a preemption blurs the one it
+//	falls in by its length. The caller runs at the top task priority
+//	for the frame (7.5 ms at most), no other task gets in.
+//
+//	A frame starts with the sensor pulling its line low. Every lane
+//	reads high until its line has risen from our own release, one
+//	still low (a slow pull-up, a long cable) would take that for the
+//	response and shift the frame. A line that never rises times out
+//	with the frame.
+//
+static void DHT11Multi_receive(uint32_t mask)
+{
+	uint32_t start = 0, now = 0, word = 0, risen = 0, done = 0;
+
+	PIN_setPortOutputValue(DHT11Multi_handle, DHT11Multi_mask);
+	start = HRTimer_now();
+	DHT11_lanesInit(&DHT11Multi_lanes, mask, start, HRTimer_fromMicros(DHT11_THRESHOLD));
+
+	do
+	{
+		word   = PIN_getPortInputValue(DHT11Multi_handle);
+		now    = HRTimer_now();
+		risen |= word;
+		done   = DHT11_lanesStep(&DHT11Multi_lanes, word | (mask & ~risen), now);
+	} while ((done != mask) && ((now - start) < HRTimer_fromMicros(DHT11_FRAME_TIMEOUT_US)));
+}
+
+//
+//	One transaction with the sensors in mask, the others keep their
+//	results. Returns the sensors that failed.
+//
+static uint32_t DHT11Multi_transact(uint32_t mask, uint8_t* results, DHT11_Reading* readings)
+{
+	uint32_t failed = 0;
+	uint8_t i = 0, numEdges = 0;
+	Int priority = 0;
+
+	//
+	//	Start pulse on the lines in mask, the device may sleep
+	//	through it.
+	//
+	PIN_setPortOutputValue(DHT11Multi_handle, DHT11Multi_mask & ~mask);
+	Task_sleep(DHT11_clockTicks(DHT11_START_US));
+
+	//
+	//	The frames need the device awake and the timestamps running.
+	//
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+	HRTimer_start();
+
+	priority = Task_setPri(Task_self(), Task_numPriorities - 1);
+	CpuLoad_begin(&DHT11Multi_receiveLoad);
+	Profile_begin(&DHT11Multi_receiveProfile);
+	DHT11Multi_receive(mask);
+	Profile_end(&DHT11Multi_receiveProfile);
+	CpuLoad_end(&DHT11Multi_receiveLoad);
+	Task_setPri(Task_self(), priority);
+
+	HRTimer_stop();
+	Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+
+	for (i = 0; i < DHT11Multi_numSensors; i++)
+	{
+		if (!((mask >> DHT11Multi_pins[i]) & 1)) continue;
+
+		results[i] = DHT11_lanesDecode(&DHT11Multi_lanes, DHT11Multi_pins[i], &numEdges, &readings[i]);
+		if (results[i] == DHT11_ERROR_TIMEOUT) DHT11Multi_timeoutPhases[i] = DHT11_edgePhase(numEdges);
+		if (results[i] != DHT11_OK) failed |= (uint32_t)1 << DHT11Multi_pins[i];
+
+		DHT11_count(results[i], DHT11Multi_timeoutPhases[i]);
+	}
+
+	return failed;
+}
+
+uint8_t DHT11Multi_read(uint8_t* results, DHT11_Reading* readings)
+{
+	uint32_t failed = 0;
+	uint8_t i = 0, retry = 0;
+
+	failed = DHT11Multi_transact(DHT11Multi_mask, results, readings);
+
+	//
+	//	Retry the sensors that failed as DHT11_pend() does, the back
+	//	off covers the sensor interval. The others sit it out.
+	//
+	for (retry = 0; failed && (retry < DHT11_RETRIES); retry++)
+	{
+		Task_sleep(DHT11_clockTicks(DHT11_backoffMs(retry) * 1000));
+
+		for (i = 0; i < DHT11Multi_numSensors; i++)
+		{
+			if ((failed >> DHT11Multi_pins[i]) & 1) DHT11_countRetry();
+		}
+
+		failed = DHT11Multi_transact(failed, results, readings);
+	}
+
+	return DHT11Multi_numSensors;
+}
+
+uint8_t DHT11Multi_getTimeoutPhase(uint8_t sensor)
+{
+	return DHT11Multi_timeoutPhases[sensor];
+}
@@ -0,0 +1,66 @@
+#ifndef __DHT11MULTI_H__
+#define __DHT11MULTI_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "DHT11Decode.h"
+
+//
+//	Several DHT11s read at once. The start pulse goes out on every
+//	sensor pin together, then the whole port is sampled in a loop
+//	and every sample is folded into the bit-parallel decoder
+//	(DHT11_lanesStep()), all sensors in one pass. A read of N
+//	sensors takes about as long as a read of one.
+//
+//	The sensors that fail are retried as DHT11_pend() does, only
+//	their lines get the next start pulse. Every result and retry is
+//	counted into the driver's DHT11_Stats, and reported after the
+//	CPU load. The lanes classify the bits as the samples come in,
+//	with the fixed DHT11_THRESHOLD: there is no frame to derive an
+//	adaptive one from, DHT11_ADAPTIVE doesn't apply.
+//
+//	Build with DHT11_MULTI=1 to read the sensors on
+//	DHT11_MULTI_PINS instead of the single DHT11 driver.
+//
+#ifndef DHT11_MULTI
+#define DHT11_MULTI							0
+#endif
+
+#define DHT11_MULTI_MAX_SENSORS	8
+
+//
+//	Sensor lines on the LaunchPad, DIO25 as for the single sensor.
+//
+#define DHT11_MULTI_PINS				PIN_ID(25), PIN_ID(24), PIN_ID(23), PIN_ID(22)
+#define DHT11_MULTI_NUM_SENSORS	4
+
+//
+//	Allocate the sensor pins, call once before BIOS_start().
+//
+void DHT11Multi_init(const PIN_Id* pins, uint8_t numSensors);
+
+//
+//	Read every sensor, must be called from a task. Each result is
+//	DHT11_OK, DHT11_ERROR_TIMEOUT or DHT11_ERROR_CHECKSUM after the
+//	retries, and the reading only written on DHT11_OK, as
+//	DHT11_read(). Returns the number of sensors read.
+//
+uint8_t DHT11Multi_read(uint8_t* results, DHT11_Reading* readings);
+
+//
+//	Phase in which the sensor's last read timed out.
+//
+uint8_t DHT11Multi_getTimeoutPhase(uint8_t sensor);
+
+#endif
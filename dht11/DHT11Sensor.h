@@ -0,0 +1,56 @@
+#ifndef __DHT11SENSOR_H__
+#define __DHT11SENSOR_H__
+
+//
+//	Sensor families. They all answer with the same 40 bit frame and
+//	bit timing, and differ in the start pulse they need, the way the
+//	bytes hold the values and how often they may be sampled. The
+//	family is chosen at build time with DHT11_SENSOR, the traits of
+//	the others are never compiled in.
+//
+//	DHT11_SENSOR_DHT11: integral and decimal bytes. The decimal
+//	byte holds tenths, the top bit of the temperature one is the
+//	sign (parts reading below 0 C).
+//	DHT11_SENSOR_DHT22 (AM2302), DHT11_SENSOR_DHT21 (AM2301): 16 bit
+//	values in tenths, MSB first, the top bit of the temperature is
+//	the sign.
+//
+#define DHT11_SENSOR_DHT11			0
+#define DHT11_SENSOR_DHT22			1
+#define DHT11_SENSOR_DHT21			2
+
+#ifndef DHT11_SENSOR
+#define DHT11_SENSOR						DHT11_SENSOR_DHT11
+#endif
+
+//
+//	Traits of the family:
+//
+//	DHT11_START_US          LOW start pulse the host sends.
+//	DHT11_INTERVAL_MS       shortest time between two samples.
+//	DHT11_HUMIDITY(bytes)   relative humidity, tenths of a percent.
+//	DHT11_TEMPERATURE(bytes) temperature, tenths of a degree C.
+//
+#if DHT11_SENSOR == DHT11_SENSOR_DHT11
+
+#define DHT11_START_US					18000
+#define DHT11_INTERVAL_MS				1000
+
+#define DHT11_HUMIDITY(bytes)		((uint16_t)(((bytes)[0] * 10) + (bytes)[1]))
+#define DHT11_TEMPERATURE(bytes)	((int16_t)((((bytes)[3] & 0x80) ? -1 : 1) * \
+											 (((bytes)[2] * 10) + ((bytes)[3] & 0x7F))))
+
+#elif (DHT11_SENSOR == DHT11_SENSOR_DHT22) || (DHT11_SENSOR == DHT11_SENSOR_DHT21)
+
+#define DHT11_START_US					1000
+#define DHT11_INTERVAL_MS				2000
+
+#define DHT11_HUMIDITY(bytes)		((uint16_t)(((bytes)[0] << 8) | (bytes)[1]))
+#define DHT11_TEMPERATURE(bytes)	((int16_t)((((bytes)[2] & 0x80) ? -1 : 1) * \
+											 ((((bytes)[2] & 0x7F) << 8) | (bytes)[3])))
+
+#else
+#error "DHT11_SENSOR: unknown sensor family"
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+
+#include <inc/hw_types.h>
+#include <inc/hw_gpt.h>
+
+#include <Board.h>
+
+#include "HRTimer.h"
+
+//
+//	Timer 2 in 32 bit mode (uses both the A and B halves).
+//
+#define HRTIMER_TIMER						Board_GPTIMER2A
+
+static GPTimerCC26XX_Handle HRTimer_handle;
+static uint32_t             HRTimer_base;
+
+void HRTimer_init(void)
+{
+	GPTimerCC26XX_Params timerParams;
+
+	//
+	//	Periodic up count over the full 32 bit range.
+	//
+	GPTimerCC26XX_Params_init(&timerParams);
+	timerParams.width          = GPT_CONFIG_32BIT;
+	timerParams.mode           = GPT_MODE_PERIODIC_UP;
+	timerParams.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+	HRTimer_handle = GPTimerCC26XX_open(HRTIMER_TIMER, &timerParams);
+	if (!HRTimer_handle) System_abort("Error opening HRTimer\n");
+
+	HRTimer_base = ((GPTimerCC26XX_HWAttrs const *)HRTimer_handle->hwAttrs)->baseAddr;
+
+	GPTimerCC26XX_setLoadValue(HRTimer_handle, 0xFFFFFFFF);
+}
+
+void HRTimer_start(void)
+{
+	GPTimerCC26XX_start(HRTimer_handle);
+}
+
+void HRTimer_stop(void)
+{
+	GPTimerCC26XX_stop(HRTimer_handle);
+}
+
+uint32_t HRTimer_now(void)
+{
+	//
+	//	Free running value, a single register read.
+	//
+	return HWREG(HRTimer_base + GPT_O_TAV);
+}
@@ -0,0 +1,97 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/UART.h>
+
+//
+//	Hot path profiler. Named regions bracket their code with
+//	Profile_begin()/Profile_end(), every run is timed in CPU cycles
+//	(Cycles.h) and added to the region's count, min, max, sum and a
+//	histogram of powers of two. The time includes the handlers that
+//	preempted the region, the max shows them.
+//
+//	Any byte received on the UART dumps the table: a line per region
+//	with its runs, min, mean and max in cycles and microseconds, then
+//	the histogram buckets that were hit, as "<=N:count" with N the
+//	bucket's upper bound in cycles. The read keeps the device out of
+//	standby, a profiling build doesn't sleep.
+//
+//	Opt in with PROFILE=1, without it the brackets compile to
+//	nothing.
+//
+#ifndef PROFILE
+#define PROFILE									0
+#endif
+
+//
+//	Bucket 0 holds runs of up to 2^PROFILE_MIN_SHIFT cycles, bucket
+//	i up to twice as many as bucket i - 1, the last one the rest.
+//
+#define PROFILE_MIN_SHIFT				5
+#define PROFILE_NUM_BUCKETS			20
+
+typedef struct Profile_Region
+{
+	const char* name;
+
+	uint32_t    start;
+	uint32_t    count;
+	uint32_t    min;
+	uint32_t    max;
+	uint64_t    sum;
+	uint32_t    buckets[PROFILE_NUM_BUCKETS];
+	Bool        linked;
+
+	struct Profile_Region* next;
+} Profile_Region;
+
+#if PROFILE
+
+//
+//	Define a region's statistics, at file scope.
+//
+#define PROFILE_REGION(var, name)	static Profile_Region var = { (name) }
+
+//
+//	Enable the cycle counter and start the task that dumps the table
+//	on request. Call once before BIOS_start(). The UART is shared with
+//	the CPU load report, the dump writes through CpuLoad_write().
+//
+void Profile_init(UART_Handle uart);
+
+//
+//	Bracket a run, callable from any context. A region must not
+//	preempt itself, regions may nest.
+//
+void Profile_begin(Profile_Region* region);
+void Profile_end(Profile_Region* region);
+
+//
+//	Write the table to the UART, and clear it.
+//
+void Profile_dump(void);
+void Profile_reset(void);
+
+#else
+
+#define PROFILE_REGION(var, name)
+#define Profile_init(uart)
+#define Profile_begin(region)
+#define Profile_end(region)
+#define Profile_dump()
+#define Profile_reset()
+
+#endif
+
+#endif
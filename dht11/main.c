@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
 //
 //	XDCtools Header files.
 //
@@ -20,19 +21,15 @@
 //
 #include <ti/drivers/PIN.h>
 #include <ti/drivers/Power.h>
+#include <ti/drivers/UART.h>
 
-//
-//	Defines for the DHT11 sensor.
-//
-#define DHT11	            				PIN_ID(25)
-#define DHT11_OK									0
-#define DHT11_ERROR_TIMEOUT				1
-#define DHT11_ERROR_CHECKSUM			2
-#define DHT11_NUM_BYTES						5
-#define DHT11_THRESHOLD						45
+#include <Board.h>
 
-#define HIGH											1
-#define LOW												0
+#include "DHT11.h"
+#include "DHT11Multi.h"
+#include "HRTimer.h"
+#include "CpuLoad.h"
+#include "Profile.h"
 
 //
 //	Default task stack size.
@@ -40,161 +37,126 @@
 #define STACK_SIZE								512
 
 //
-//	Task structure and stack.
+//	Clock ticks of a time in milliseconds, whatever the .cfg sets
+//	Clock.tickPeriod to.
 //
-Task_Struct DHT11_taskStruct;
-Char DHT11_taskStack[STACK_SIZE];
+#define MS_TO_TICKS(ms)						(((ms) * 1000) / Clock_tickPeriod)
 
 //
-//	PIN driver handle.
+//	Time between two reads. A single sensor is read through the
+//	sample cache, which keeps to the sensor family's minimum at any
+//	rate. DHT11Multi_read() doesn't, the period has to.
 //
-PIN_Handle DHT11_handle;
-PIN_State  DHT11_state;
+#define SAMPLE_PERIOD_MS					3000
+
+#if DHT11_MULTI && (SAMPLE_PERIOD_MS < DHT11_INTERVAL_MS)
+#error "SAMPLE_PERIOD_MS is shorter than the sensor's sampling interval"
+#endif
 
 //
-//	PIN initial configuration table - I/O.
+//	Arguments printing a value in tenths, a signed one with "%s%d.%d"
+//	and an unsigned one with "%d.%d".
 //
-PIN_Config gpioInitConfig[] =
-{
-	DHT11 | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	PIN_TERMINATE
-};
+#define SIGNED_TENTHS(value)			((value) < 0) ? "-" : "", abs(value) / 10, abs(value) % 10
+#define TENTHS(value)							(value) / 10, (value) % 10
 
 //
-//	DHT11 pin configuration tables.
+//	Task structure and stack.
 //
-PIN_Config DHT11_outputConfig[] =
-{
-	DHT11 | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	PIN_TERMINATE
-};
+Task_Struct DHT11_taskStruct;
+Char DHT11_taskStack[STACK_SIZE];
 
-PIN_Config DHT11_inputConfig[] =
+//
+//	PIN initial configuration table - I/O.
+//
+PIN_Config gpioInitConfig[] =
 {
-	DHT11 | PIN_INPUT_EN | PIN_NOPULL,
+	DHT11 | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_PUSHPULL | PIN_DRVSTR_MAX,
 	PIN_TERMINATE
 };
 
-uint8_t skipPulse(uint8_t state)
-{
-	uint16_t loopCnt = 10000;
+CPULOAD_HANDLER(DHT11_taskLoad, "main", CPULOAD_TASK);
+PROFILE_REGION(DHT11_readProfile, "readSensor");
 
-	//
-	//	Loop until the passed state has been reached.
-	//
-	while (PIN_getInputValue(DHT11) == state)
-		if (loopCnt-- == 0) return DHT11_ERROR_TIMEOUT;
+#if DHT11_MULTI
 
-	return DHT11_OK;
-}
+static const PIN_Id DHT11_pins[DHT11_MULTI_NUM_SENSORS] = { DHT11_MULTI_PINS };
 
-uint8_t readSensor(uint8_t* temperature, uint8_t* humidity)
+void DHT11_task(UArg arg0, UArg arg1)
 {
-	//
-	//	Allocate collection of pins based on the DHT11_outputConfig table.
-	//
-	DHT11_handle = PIN_open(&DHT11_state, DHT11_outputConfig);
-	if (!DHT11_handle) System_abort("Error allocating pins - DHT11_outputConfig\n");
-
-	//
-	//	Data buffer.
-	//
- 	uint8_t bytes[DHT11_NUM_BYTES];
-	uint8_t i = 0, j = 0;
-
-	//
-	//	Zero out the data buffer.
-	//
-	for (i = 0; i < DHT11_NUM_BYTES; i++) bytes[i] = 0;
-
-	//
-	//	Request sample.
-	//
-	PIN_setOutputValue(DHT11_handle, DHT11, LOW);
-	//
-	//	Sleep for 18 ms.
-	//
-	Task_sleep(18000 / Clock_tickPeriod);
-
-	//
-	//	Deallocate pins to return to the initial configuration.
-	//
-	PIN_close(DHT11_handle);
+	DHT11_Reading readings[DHT11_MULTI_NUM_SENSORS];
+	uint8_t results[DHT11_MULTI_NUM_SENSORS];
+	uint8_t i = 0;
 
-	//
-	//	Allocate collection of pins based on the DHT11_inputConfig table.
-	//
-	DHT11_handle = PIN_open(&DHT11_state, DHT11_inputConfig);
-	if (!DHT11_handle) System_abort("Error allocating pins - DHT11_inputConfig\n");
-
-	//
-	//	Skip the following pulses.
-	//
-	if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-	if (skipPulse(LOW))  return DHT11_ERROR_TIMEOUT;
-	if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-
-	//
-	//	Read output - 40 bits => 5 bytes or timeout.
-	//
-	UInt32 lastTick = 0, width = 0;
-	for (i = 0; i < DHT11_NUM_BYTES; i++)
+	while(1)
 	{
-		for (j = 0; j < 8; j++)
-		{
-			if (skipPulse(LOW))  return DHT11_ERROR_TIMEOUT;
-
-			lastTick = Clock_getTicks();
-
-			if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-
-			//
-			//	Calculate width of last HIGH pulse.
-			//
-			width = (Clock_getTicks() - lastTick) * Clock_tickPeriod;
+		//
+		//	Read every sensor at once and print a line for each.
+		//
+		Profile_begin(&DHT11_readProfile);
+		DHT11Multi_read(results, readings);
+		Profile_end(&DHT11_readProfile);
 
-			//
-			//	Shift in the data, msb first if width > threshold.
-			//
-			bytes[i] |= ((width > DHT11_THRESHOLD) << (7 - j));
+		CpuLoad_begin(&DHT11_taskLoad);
+		for (i = 0; i < DHT11_MULTI_NUM_SENSORS; i++)
+		{
+			switch (results[i])
+			{
+				case DHT11_OK:
+					System_printf("sensor %d: temperature: %s%d.%d, humidity: %d.%d\n", i,
+					              SIGNED_TENTHS(readings[i].temperature), TENTHS(readings[i].humidity));
+					break;
+
+				case DHT11_ERROR_TIMEOUT:
+					System_printf("sensor %d: DHT11_ERROR_TIMEOUT, phase: %d\n", i, DHT11Multi_getTimeoutPhase(i));
+					break;
+
+				case DHT11_ERROR_CHECKSUM:
+					System_printf("sensor %d: DHT11_ERROR_CHECKSUM\n", i);
+					break;
+			}
 		}
-	}
 
-	//
-	//	Checksum will overflow automatically.
-	//
-	uint8_t checkSum = 0;
-	for (i = 0; i < (DHT11_NUM_BYTES - 1); i++)  checkSum += bytes[i];
-	if (checkSum != bytes[4]) return DHT11_ERROR_CHECKSUM;
+		System_flush();
+		CpuLoad_end(&DHT11_taskLoad);
 
-	*humidity    = bytes[0];
-	*temperature = bytes[2];
+		Task_sleep(MS_TO_TICKS(SAMPLE_PERIOD_MS));
+	}
+}
 
-	//
-	//	Deallocate pins to return to the initial configuration.
-	//
-	PIN_close(DHT11_handle);
+#else
 
-	return DHT11_OK;
+uint8_t readSensor(DHT11_Sample* sample, uint32_t* age)
+{
+	return DHT11_get(sample, age);
 }
 
 void DHT11_task(UArg arg0, UArg arg1)
 {
-	uint8_t temperature = 0, humidity = 0;
+	DHT11_Sample sample;
+	uint32_t     age = 0;
+	uint8_t      result = DHT11_OK;
 
 	while(1)
 	{
 		//
 		//	Read sensor and print output.
 		//
-		switch (readSensor(&temperature, &humidity))
+		Profile_begin(&DHT11_readProfile);
+		result = readSensor(&sample, &age);
+		Profile_end(&DHT11_readProfile);
+
+		CpuLoad_begin(&DHT11_taskLoad);
+		switch (result)
 		{
 			case DHT11_OK:
-				System_printf("temperature: %d, humidity: %d\n", temperature, humidity);
+				System_printf("temperature: %s%d.%d, humidity: %d.%d, threshold: %d, age: %d ms\n",
+				              SIGNED_TENTHS(sample.reading.temperature), TENTHS(sample.reading.humidity),
+				              DHT11_getThreshold(), age);
 				break;
 
 			case DHT11_ERROR_TIMEOUT:
-				System_printf("DHT11_ERROR_TIMEOUT\n");
+				System_printf("DHT11_ERROR_TIMEOUT, phase: %d\n", DHT11_getTimeoutPhase());
 				break;
 
 			case DHT11_ERROR_CHECKSUM:
@@ -203,13 +165,19 @@ void DHT11_task(UArg arg0, UArg arg1)
 		}
 
 		System_flush();
-		Task_sleep(3000000 / Clock_tickPeriod);
+		CpuLoad_end(&DHT11_taskLoad);
+
+		Task_sleep(MS_TO_TICKS(SAMPLE_PERIOD_MS));
 	}
 }
 
+#endif
+
 int main(void)
 {
 	Task_Params DHT11_taskParams;
+	UART_Params uartParams;
+	UART_Handle uart;
 
 	//
 	//	Power manager initialization.
@@ -224,6 +192,34 @@ int main(void)
 		System_abort("Error initializing PIN module\n");
 	}
 
+	//
+	//	High resolution timestamp and DHT11 driver initialization.
+	//
+	HRTimer_init();
+#if DHT11_MULTI
+	DHT11Multi_init(DHT11_pins, DHT11_MULTI_NUM_SENSORS);
+#else
+	DHT11_init();
+#endif
+
+	//
+	//	CPU load reports and profile dumps over the UART.
+	//
+	Board_initUART();
+	UART_Params_init(&uartParams);
+	uartParams.writeDataMode = UART_DATA_TEXT;
+	uartParams.readDataMode  = UART_DATA_TEXT;
+	uartParams.readEcho      = UART_ECHO_OFF;
+	uartParams.baudRate      = 115200;
+	uart = UART_open(Board_UART0, &uartParams);
+	if (!uart)
+	{
+		System_abort("Error opening the UART\n");
+	}
+
+	CpuLoad_init(uart);
+	Profile_init(uart);
+
 	//
 	//	Construct DHT11 task thread.
 	//
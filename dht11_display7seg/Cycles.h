@@ -0,0 +1,31 @@
+#ifndef __CYCLES_H__
+#define __CYCLES_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+//
+//	CPU cycle counts from the Cortex-M3 DWT cycle counter, 48 per
+//	microsecond. The counter stops while the CPU sleeps, so a count
+//	across a blocking call is the CPU time spent meanwhile, by any
+//	thread. It wraps after ~89 s, differences of two counts are valid
+//	across the wrap when taken as uint32_t.
+//
+#define CYCLES_PER_US						48
+
+#define Cycles_toMicros(cycles)	((cycles) / CYCLES_PER_US)
+
+//
+//	Enable and clear the counter, call before BIOS_start(). The load
+//	monitor and the profiler both do.
+//
+void Cycles_init(void);
+
+//
+//	Current count, callable from any context.
+//
+uint32_t Cycles_now(void);
+
+#endif
@@ -0,0 +1,823 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include "DHT11.h"
+#include "HRTimer.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+
+#if DHT11_MODE == DHT11_MODE_CAPTURE
+#include <ti/drivers/pin/PINCC26XX.h>
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+#include <ti/drivers/dma/UDMACC26XX.h>
+
+#include <inc/hw_memmap.h>
+#include <inc/hw_types.h>
+#include <inc/hw_gpt.h>
+#include <driverlib/ioc.h>
+#include <driverlib/timer.h>
+#include <driverlib/udma.h>
+
+#include <Board.h>
+#endif
+
+//
+//	General logic states.
+//
+#define HIGH										1
+#define LOW											0
+
+//
+//	Transaction states.
+//
+#define DHT11_STATE_IDLE				0
+#define DHT11_STATE_START				1
+#define DHT11_STATE_CAPTURE			2
+#define DHT11_STATE_DECODE			3
+
+//
+//	PIN driver handle.
+//
+static PIN_Handle DHT11_handle;
+static PIN_State  DHT11_state;
+
+//
+//	DHT11 pin configuration table. The pin is open-drain with the
+//	input buffer always enabled: writing LOW drives the start pulse,
+//	writing HIGH releases the line to the sensor's pull-up. The
+//	handle is opened once, switching direction is a single write.
+//
+static PIN_Config DHT11_pinTable[] =
+{
+	DHT11 | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_OPENDRAIN | PIN_INPUT_EN | PIN_NOPULL,
+	PIN_TERMINATE
+};
+
+//
+//	Start pulse and frame timeout clocks.
+//
+static Clock_Struct DHT11_startClkStruct;
+static Clock_Handle DHT11_startClk;
+
+#if DHT11_MODE != DHT11_MODE_POLL
+static Clock_Struct DHT11_timeoutClkStruct;
+static Clock_Handle DHT11_timeoutClk;
+#endif
+
+//
+//	Transaction done semaphore, posted when a result is ready.
+//
+static Semaphore_Struct DHT11_doneSemStruct;
+static Semaphore_Handle DHT11_doneSem;
+
+//
+//	Current transaction.
+//
+static volatile uint8_t DHT11_currentState = DHT11_STATE_IDLE;
+static uint8_t DHT11_result = DHT11_OK;
+static DHT11_Reading DHT11_reading;
+
+//
+//	Phase of the last timeout.
+//
+static uint8_t DHT11_timeoutPhase = DHT11_PHASE_RESPONSE;
+
+//
+//	Transaction counters.
+//
+static DHT11_Stats DHT11_stats;
+
+//
+//	Published samples, two copies under a sequence count. The
+//	publication makes the count odd, updates copy 0, makes it even
+//	and updates copy 1: a reader takes the copy the count says is
+//	not being updated and retries if the count moved meanwhile. A
+//	reader that preempted the publication sees no move and never
+//	retries, a preempted one retries once per publication.
+//
+static volatile uint32_t     DHT11_sampleCount;
+static volatile DHT11_Sample DHT11_samples[2] = { { 0, 0, DHT11_NO_SAMPLE }, { 0, 0, DHT11_NO_SAMPLE } };
+
+//
+//	Clock tick the last transaction started at, the sensor needs
+//	DHT11_INTERVAL_MS before the next.
+//
+static Bool     DHT11_started;
+static uint32_t DHT11_startTick;
+
+//
+//	Set while DHT11_pend() waits to retry, the retry owns the driver
+//	and DHT11_start() refuses other callers.
+//
+static volatile Bool DHT11_retrying;
+
+//
+//	Sample cache gate, one DHT11_get() caller at a time.
+//
+static Semaphore_Struct DHT11_cacheSemStruct;
+static Semaphore_Handle DHT11_cacheSem;
+
+//
+//	Edge timestamps of the current frame.
+//
+static volatile uint32_t DHT11_edges[DHT11_NUM_EDGES];
+
+#if DHT11_MODE == DHT11_MODE_EDGE
+static volatile uint8_t DHT11_edgeCount;
+#endif
+
+#if DHT11_MODE == DHT11_MODE_CAPTURE
+//
+//	Capture timer and the uDMA channel it triggers. The edge-time
+//	capture is 16 bits plus the 8 bit prescaler, at the same 48 MHz
+//	as HRTimer.
+//
+#define DHT11_CAPTURE_TIMER			Board_GPTIMER1A
+#define DHT11_CAPTURE_DMA_CH		UDMA_CHAN_TIMER1_A
+#define DHT11_EDGE_MASK					0x00FFFFFF
+
+static GPTimerCC26XX_Handle DHT11_timer;
+static UDMACC26XX_Handle    DHT11_dma;
+static uint32_t             DHT11_timerBase;
+
+//
+//	uDMA control table entry for the capture channel.
+//
+ALLOCATE_CONTROL_TABLE_ENTRY(DHT11_dmaControlTableEntry, DHT11_CAPTURE_DMA_CH);
+
+static void DHT11_captureCallback(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask);
+#else
+//
+//	HRTimer timestamps use the full 32 bits.
+//
+#define DHT11_EDGE_MASK					0xFFFFFFFF
+#endif
+
+#if DHT11_ADAPTIVE
+#define DHT11_BIT_THRESHOLD			DHT11_THRESHOLD_AUTO
+#else
+#define DHT11_BIT_THRESHOLD			HRTimer_fromMicros(DHT11_THRESHOLD)
+#endif
+
+static void DHT11_startClock(UArg arg0);
+#if DHT11_MODE != DHT11_MODE_POLL
+static void DHT11_timeoutClock(UArg arg0);
+static void DHT11_complete(void);
+#endif
+
+//
+//	CPU load accounting of the handlers.
+//
+CPULOAD_HANDLER(DHT11_startLoad, "dht11 start", CPULOAD_SWI);
+#if DHT11_MODE == DHT11_MODE_POLL
+CPULOAD_HANDLER(DHT11_receiveLoad, "dht11 receive", CPULOAD_TASK);
+#else
+CPULOAD_HANDLER(DHT11_timeoutLoad, "dht11 timeout", CPULOAD_SWI);
+#endif
+#if DHT11_MODE == DHT11_MODE_EDGE
+CPULOAD_HANDLER(DHT11_edgeLoad, "dht11 edge", CPULOAD_SWI);
+#elif DHT11_MODE == DHT11_MODE_CAPTURE
+CPULOAD_HANDLER(DHT11_captureLoad, "dht11 capture", CPULOAD_HWI);
+#endif
+
+//
+//	Profiled regions.
+//
+PROFILE_REGION(DHT11_decodeProfile, "DHT11_decode");
+#if DHT11_MODE == DHT11_MODE_POLL
+PROFILE_REGION(DHT11_skipPulseProfile, "skipPulse");
+#endif
+
+#if CPULOAD
+
+//
+//	Telemetry line sent after the CPU load report.
+//
+static Int DHT11_report(char* line)
+{
+	DHT11_Stats stats;
+
+	DHT11_getStats(&stats);
+
+	return System_sprintf(line, "dht11: reads %u, retries %u, checksum errors %u, timeouts response %u, bit low %u, bit high %u\n",
+	                      stats.reads, stats.retries, stats.checksums, stats.timeouts[DHT11_PHASE_RESPONSE],
+	                      stats.timeouts[DHT11_PHASE_BIT_LOW], stats.timeouts[DHT11_PHASE_BIT_HIGH]);
+}
+
+#endif
+
+void DHT11_addReport(void)
+{
+	CpuLoad_addReport(DHT11_report);
+}
+
+void DHT11_init(void)
+{
+	Semaphore_Params semParams;
+	Clock_Params     clkParams;
+
+	//
+	//	Allocate the DHT11 pin for the lifetime of the driver.
+	//
+	DHT11_handle = PIN_open(&DHT11_state, DHT11_pinTable);
+	if (!DHT11_handle) System_abort("Error allocating pins - DHT11_pinTable\n");
+
+	//
+	//	Construct the binary transaction done and cache semaphores.
+	//
+	Semaphore_Params_init(&semParams);
+	semParams.mode = Semaphore_Mode_BINARY;
+	Semaphore_construct(&DHT11_doneSemStruct, 0, &semParams);
+	DHT11_doneSem = Semaphore_handle(&DHT11_doneSemStruct);
+	Semaphore_construct(&DHT11_cacheSemStruct, 1, &semParams);
+	DHT11_cacheSem = Semaphore_handle(&DHT11_cacheSemStruct);
+
+	//
+	//	Construct the one-shot clocks, started per transaction.
+	//
+	Clock_Params_init(&clkParams);
+	clkParams.period = 0;
+	clkParams.startFlag = FALSE;
+	Clock_construct(&DHT11_startClkStruct, (Clock_FuncPtr)DHT11_startClock, DHT11_clockTicks(DHT11_START_US), &clkParams);
+	DHT11_startClk = Clock_handle(&DHT11_startClkStruct);
+
+#if DHT11_MODE != DHT11_MODE_POLL
+	Clock_construct(&DHT11_timeoutClkStruct, (Clock_FuncPtr)DHT11_timeoutClock,
+	                DHT11_clockTicks(DHT11_FRAME_TIMEOUT_US), &clkParams);
+	DHT11_timeoutClk = Clock_handle(&DHT11_timeoutClkStruct);
+#endif
+
+	DHT11_addReport();
+
+#if DHT11_MODE == DHT11_MODE_CAPTURE
+	GPTimerCC26XX_Params timerParams;
+
+	//
+	//	Edge-time capture on both edges, free running over the full
+	//	24 bit range so the difference of two captures is a width.
+	//
+	GPTimerCC26XX_Params_init(&timerParams);
+	timerParams.width          = GPT_CONFIG_16BIT;
+	timerParams.mode           = GPT_MODE_EDGE_TIME_UP;
+	timerParams.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+	DHT11_timer = GPTimerCC26XX_open(DHT11_CAPTURE_TIMER, &timerParams);
+	if (!DHT11_timer) System_abort("Error opening DHT11 capture timer\n");
+
+	DHT11_timerBase = ((GPTimerCC26XX_HWAttrs const *)DHT11_timer->hwAttrs)->baseAddr;
+
+	GPTimerCC26XX_setLoadValue(DHT11_timer, DHT11_EDGE_MASK);
+	GPTimerCC26XX_setCaptureEdge(DHT11_timer, GPTimerCC26XX_BOTH_EDGES);
+
+	//
+	//	Every capture event is a uDMA request, the CPU is only
+	//	interrupted by the DMA done event at the end of the frame.
+	//
+	HWREG(DHT11_timerBase + GPT_O_DMAEV) = GPT_DMAEV_CAEDMAEN;
+	GPTimerCC26XX_registerInterrupt(DHT11_timer, DHT11_captureCallback, 0);
+
+	DHT11_dma = UDMACC26XX_open();
+	if (!DHT11_dma) System_abort("Error opening uDMA\n");
+#endif
+}
+
+//
+//	Switch the line from the start pulse over to the sensor.
+//
+static void DHT11_release(void)
+{
+	PIN_setOutputValue(DHT11_handle, DHT11, HIGH);
+}
+
+//
+//	The frame needs the device awake, its edges are timestamped by
+//	the HRTimer (or captured by a GPTimer) and GPTimers stop in
+//	standby. The start pulse doesn't, the IOs hold their level
+//	through standby, so between frames the device can sleep.
+//
+static void DHT11_wake(void)
+{
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+#if DHT11_MODE != DHT11_MODE_CAPTURE
+	HRTimer_start();
+#endif
+}
+
+static void DHT11_sleep(void)
+{
+#if DHT11_MODE != DHT11_MODE_CAPTURE
+	HRTimer_stop();
+#endif
+	Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+}
+
+//
+//	Publish the transaction result. Only ever runs once per
+//	transaction, from one context at a time.
+//
+static void DHT11_publish(void)
+{
+	DHT11_Sample sample;
+
+	sample.sequence  = (DHT11_sampleCount >> 1) + 1;
+	sample.timestamp = Clock_getTicks();
+	sample.result    = DHT11_result;
+	sample.reading   = DHT11_reading;
+
+	DHT11_sampleCount++;
+	DHT11_samples[0] = sample;
+	DHT11_sampleCount++;
+	DHT11_samples[1] = sample;
+}
+
+//
+//	The counters are shared by every context, DHT11_getStats() takes
+//	them with Hwis disabled.
+//
+void DHT11_count(uint8_t result, uint8_t phase)
+{
+	UInt key = Hwi_disable();
+
+	if (result == DHT11_OK)
+	{
+		DHT11_stats.reads++;
+	}
+	else if (result == DHT11_ERROR_TIMEOUT)
+	{
+		DHT11_stats.timeouts[phase]++;
+	}
+	else
+	{
+		DHT11_stats.checksums++;
+	}
+
+	Hwi_restore(key);
+}
+
+void DHT11_countRetry(void)
+{
+	UInt key = Hwi_disable();
+	DHT11_stats.retries++;
+	Hwi_restore(key);
+}
+
+//
+//	Decode the captured edges and store the transaction result,
+//	the line is free again.
+//
+static void DHT11_finish(uint8_t numEdges)
+{
+	DHT11_sleep();
+
+	Profile_begin(&DHT11_decodeProfile);
+	DHT11_result = DHT11_decode((const uint32_t *)DHT11_edges, numEdges, DHT11_EDGE_MASK,
+	                            DHT11_BIT_THRESHOLD, &DHT11_reading);
+	Profile_end(&DHT11_decodeProfile);
+
+	if (DHT11_result == DHT11_ERROR_TIMEOUT) DHT11_timeoutPhase = DHT11_edgePhase(numEdges);
+	DHT11_count(DHT11_result, DHT11_timeoutPhase);
+
+	DHT11_publish();
+
+	DHT11_currentState = DHT11_STATE_IDLE;
+}
+
+#if DHT11_MODE == DHT11_MODE_POLL
+
+//
+//	Timeout budget per phase, in microseconds.
+//
+static const uint32_t DHT11_phaseBudget[] =
+{
+	DHT11_TIMEOUT_RESPONSE_US,
+	DHT11_TIMEOUT_BIT_LOW_US,
+	DHT11_TIMEOUT_BIT_HIGH_US
+};
+
+static uint8_t skipPulse(uint8_t state, uint32_t timeoutUs)
+{
+	uint32_t start   = HRTimer_now();
+	uint32_t timeout = HRTimer_fromMicros(timeoutUs);
+
+	//
+	//	Loop until the passed state has been left, or the
+	//	phase budget is spent.
+	//
+	while (PIN_getInputValue(DHT11) == state)
+	{
+		if ((HRTimer_now() - start) > timeout) return DHT11_ERROR_TIMEOUT;
+	}
+
+	return DHT11_OK;
+}
+
+//
+//	Timestamp every edge of the frame, returns how many arrived
+//	within their budget.
+//
+//	Swis and Hwis stay enabled, the display refresh keeps running
+//	through the frame. A preemption only makes the edge seen late by
+//	the length of the handler: the widths are measured between
+//	HRTimer timestamps rather than counted in loop iterations, the
+//	budgets leave more than the handler's length of slack, and the
+//	adaptive threshold absorbs the error on the width.
+//
+static uint8_t DHT11_receive(void)
+{
+	uint8_t count = 0, level = HIGH, result = DHT11_OK;
+
+	//
+	//	The frame starts with the sensor pulling the line low. A line
+	//	still low from our own release (a slow pull-up, a long cable)
+	//	must not pass for it, no rise within the response budget is a
+	//	response timeout.
+	//
+	if (skipPulse(LOW, DHT11_TIMEOUT_RESPONSE_US)) return 0;
+
+	for (count = 0; count < DHT11_NUM_EDGES; count++)
+	{
+		Profile_begin(&DHT11_skipPulseProfile);
+		result = skipPulse(level, DHT11_phaseBudget[DHT11_edgePhase(count)]);
+		Profile_end(&DHT11_skipPulseProfile);
+		if (result) break;
+
+		DHT11_edges[count] = HRTimer_now();
+		level = !level;
+	}
+
+	return count;
+}
+
+//
+//	End of the start pulse. Polling can't run in Swi context, so
+//	the waiting reader releases the line and receives the frame.
+//
+static void DHT11_startClock(UArg arg0)
+{
+	CpuLoad_begin(&DHT11_startLoad);
+
+	DHT11_wake();
+	DHT11_currentState = DHT11_STATE_CAPTURE;
+	Semaphore_post(DHT11_doneSem);
+
+	CpuLoad_end(&DHT11_startLoad);
+}
+
+#else
+
+#if DHT11_MODE == DHT11_MODE_EDGE
+
+//
+//	PIN interrupt callback, timestamps every edge of the frame
+//	and completes the transaction once the last one arrives.
+//
+static void DHT11_edgeCallback(PIN_Handle handle, PIN_Id pinId)
+{
+	CpuLoad_begin(&DHT11_edgeLoad);
+
+	//
+	//	The frame starts with the sensor pulling the line low, drop
+	//	a late event from our own release of the line.
+	//
+	if ((DHT11_edgeCount == 0) && PIN_getInputValue(DHT11))
+	{
+		CpuLoad_end(&DHT11_edgeLoad);
+		return;
+	}
+
+	if (DHT11_edgeCount < DHT11_NUM_EDGES)
+	{
+		DHT11_edges[DHT11_edgeCount++] = HRTimer_now();
+
+		if (DHT11_edgeCount == DHT11_NUM_EDGES) DHT11_complete();
+	}
+
+	CpuLoad_end(&DHT11_edgeLoad);
+}
+
+static void DHT11_arm(void)
+{
+	DHT11_edgeCount = 0;
+	PIN_registerIntCb(DHT11_handle, DHT11_edgeCallback);
+	PIN_setInterrupt(DHT11_handle, DHT11 | PIN_IRQ_BOTHEDGES);
+}
+
+static uint8_t DHT11_disarm(void)
+{
+	PIN_setInterrupt(DHT11_handle, DHT11 | PIN_IRQ_DIS);
+
+	return DHT11_edgeCount;
+}
+
+#elif DHT11_MODE == DHT11_MODE_CAPTURE
+
+//
+//	GPTimer interrupt callback, only the DMA done event is enabled
+//	so this runs once when the last capture has been stored.
+//
+static void DHT11_captureCallback(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask)
+{
+	CpuLoad_begin(&DHT11_captureLoad);
+
+	TimerIntClear(DHT11_timerBase, TIMER_TIMA_DMA);
+	UDMACC26XX_clearInterrupt(DHT11_dma, (1 << DHT11_CAPTURE_DMA_CH));
+
+	DHT11_complete();
+
+	CpuLoad_end(&DHT11_captureLoad);
+}
+
+static void DHT11_arm(void)
+{
+	uint32_t start = 0;
+
+	//
+	//	One 32 bit transfer from the capture register per edge.
+	//
+	uDMAChannelControlSet(UDMA0_BASE, DHT11_CAPTURE_DMA_CH | UDMA_PRI_SELECT,
+	                      UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | UDMA_ARB_1);
+	uDMAChannelTransferSet(UDMA0_BASE, DHT11_CAPTURE_DMA_CH | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+	                       (void *)(DHT11_timerBase + GPT_O_TAR), (void *)DHT11_edges, DHT11_NUM_EDGES);
+
+	UDMACC26XX_channelEnable(DHT11_dma, (1 << DHT11_CAPTURE_DMA_CH));
+	TimerIntEnable(DHT11_timerBase, TIMER_TIMA_DMA);
+	GPTimerCC26XX_start(DHT11_timer);
+
+	//
+	//	The frame starts with the sensor pulling the line low. The pin
+	//	only goes to the capture once the line has risen from our own
+	//	release, so that edge can't take the first slot. A line still
+	//	low after the response budget is left to the frame timeout.
+	//
+	start = GPTimerCC26XX_getFreeRunValue(DHT11_timer);
+	while (!PIN_getInputValue(DHT11) &&
+	       (((GPTimerCC26XX_getFreeRunValue(DHT11_timer) - start) & DHT11_EDGE_MASK) < HRTimer_fromMicros(DHT11_TIMEOUT_RESPONSE_US)));
+
+	PINCC26XX_setMux(DHT11_handle, DHT11, GPTimerCC26XX_getPinMux(DHT11_timer));
+}
+
+static uint8_t DHT11_disarm(void)
+{
+	GPTimerCC26XX_stop(DHT11_timer);
+	TimerIntDisable(DHT11_timerBase, TIMER_TIMA_DMA);
+	UDMACC26XX_channelDisable(DHT11_dma, (1 << DHT11_CAPTURE_DMA_CH));
+	PINCC26XX_setMux(DHT11_handle, DHT11, IOC_PORT_GPIO);
+
+	//
+	//	The remaining transfer count tells how far the frame got.
+	//
+	return DHT11_NUM_EDGES - uDMAChannelSizeGet(UDMA0_BASE, DHT11_CAPTURE_DMA_CH | UDMA_PRI_SELECT);
+}
+
+#endif
+
+//
+//	End of the frame, from the edge/DMA interrupt or the timeout
+//	clock. Whichever comes first completes the transaction.
+//
+static void DHT11_complete(void)
+{
+	UInt key = Hwi_disable();
+	if (DHT11_currentState != DHT11_STATE_CAPTURE)
+	{
+		Hwi_restore(key);
+		return;
+	}
+	DHT11_currentState = DHT11_STATE_DECODE;
+	Hwi_restore(key);
+
+	Clock_stop(DHT11_timeoutClk);
+	DHT11_finish(DHT11_disarm());
+	Semaphore_post(DHT11_doneSem);
+}
+
+//
+//	End of the start pulse, hand the line over to the sensor and
+//	arm the capture with the frame timeout running.
+//
+static void DHT11_startClock(UArg arg0)
+{
+	CpuLoad_begin(&DHT11_startLoad);
+
+	DHT11_wake();
+	DHT11_release();
+
+	DHT11_currentState = DHT11_STATE_CAPTURE;
+	DHT11_arm();
+	Clock_start(DHT11_timeoutClk);
+
+	CpuLoad_end(&DHT11_startLoad);
+}
+
+static void DHT11_timeoutClock(UArg arg0)
+{
+	CpuLoad_begin(&DHT11_timeoutLoad);
+	DHT11_complete();
+	CpuLoad_end(&DHT11_timeoutLoad);
+}
+
+#endif
+
+//
+//	Start a transaction, for a retry of DHT11_pend() even while it
+//	owns the driver.
+//
+static Bool DHT11_request(Bool retry)
+{
+	//
+	//	Only one transaction at a time, and no sooner than the sensor
+	//	allows after the last.
+	//
+	UInt key = Hwi_disable();
+	if ((DHT11_retrying && !retry) || (DHT11_currentState != DHT11_STATE_IDLE) ||
+	    (DHT11_started && ((Clock_getTicks() - DHT11_startTick) < DHT11_clockTicks(DHT11_INTERVAL_MS * 1000))))
+	{
+		Hwi_restore(key);
+		return FALSE;
+	}
+	DHT11_currentState = DHT11_STATE_START;
+	DHT11_started      = TRUE;
+	DHT11_startTick    = Clock_getTicks();
+	DHT11_retrying     = FALSE;
+	Hwi_restore(key);
+
+	//
+	//	Request sample, the start clock ends the start pulse.
+	//
+	PIN_setOutputValue(DHT11_handle, DHT11, LOW);
+	Clock_start(DHT11_startClk);
+
+	return TRUE;
+}
+
+Bool DHT11_start(void)
+{
+	return DHT11_request(FALSE);
+}
+
+//
+//	Wait for the running transaction to complete.
+//
+static void DHT11_wait(void)
+{
+	Semaphore_pend(DHT11_doneSem, BIOS_WAIT_FOREVER);
+
+#if DHT11_MODE == DHT11_MODE_POLL
+	//
+	//	Woken at the end of the start pulse, receive the frame here.
+	//
+	CpuLoad_begin(&DHT11_receiveLoad);
+	DHT11_release();
+	DHT11_finish(DHT11_receive());
+	CpuLoad_end(&DHT11_receiveLoad);
+#endif
+}
+
+uint8_t DHT11_pend(int16_t* temperature, uint16_t* humidity)
+{
+	uint8_t retry = 0;
+
+	DHT11_wait();
+
+	for (retry = 0; (DHT11_result != DHT11_OK) && (retry < DHT11_RETRIES); retry++)
+	{
+		//
+		//	Back off for at least the sensor interval, the start then
+		//	can't be refused for coming too soon. Nobody else starts a
+		//	transaction meanwhile, its completion would pass for the
+		//	retry's and a polled frame would go unreceived.
+		//
+		DHT11_retrying = TRUE;
+		Task_sleep(DHT11_clockTicks(DHT11_backoffMs(retry) * 1000));
+		DHT11_countRetry();
+
+		if (!DHT11_request(TRUE)) break;
+		DHT11_wait();
+	}
+
+	DHT11_retrying = FALSE;
+
+	if (DHT11_result != DHT11_OK) return DHT11_result;
+
+	if (humidity)    *humidity    = DHT11_reading.humidity;
+	if (temperature) *temperature = DHT11_reading.temperature;
+
+	return DHT11_OK;
+}
+
+uint8_t DHT11_read(int16_t* temperature, uint16_t* humidity)
+{
+	DHT11_Sample sample;
+
+	if (DHT11_get(&sample, NULL) != DHT11_OK) return sample.result;
+
+	if (humidity)    *humidity    = sample.reading.humidity;
+	if (temperature) *temperature = sample.reading.temperature;
+
+	return DHT11_OK;
+}
+
+//
+//	Run a transaction through the cache gate. Returns FALSE when the
+//	last one started too recently.
+//
+static Bool DHT11_fetch(uint8_t* result)
+{
+	Bool started = FALSE;
+
+	Semaphore_pend(DHT11_cacheSem, BIOS_WAIT_FOREVER);
+
+	started = DHT11_start();
+	if (started)
+	{
+		DHT11_wait();
+		*result = DHT11_result;
+	}
+
+	Semaphore_post(DHT11_cacheSem);
+
+	return started;
+}
+
+uint8_t DHT11_get(DHT11_Sample* sample, uint32_t* age)
+{
+	uint8_t result = DHT11_OK, retry = 0;
+
+	//
+	//	The first caller past the interval reads the sensor, the ones
+	//	that queued up meanwhile find its sample in the cache. It
+	//	retries without the gate held, through the pauses the others
+	//	get the cached sample, and one that gets past the interval
+	//	first runs the next transaction in its place.
+	//
+	if (DHT11_fetch(&result))
+	{
+		for (retry = 0; (result != DHT11_OK) && (retry < DHT11_RETRIES); retry++)
+		{
+			Task_sleep(DHT11_clockTicks(DHT11_backoffMs(retry) * 1000));
+			if (!DHT11_fetch(&result)) break;
+
+			DHT11_countRetry();
+		}
+	}
+
+	DHT11_getSample(sample);
+
+	if (age) *age = (uint32_t)(((uint64_t)(Clock_getTicks() - sample->timestamp) * Clock_tickPeriod) / 1000);
+
+	return sample->result;
+}
+
+uint32_t DHT11_getSample(DHT11_Sample* sample)
+{
+	uint32_t count = 0;
+
+	do
+	{
+		count   = DHT11_sampleCount;
+		*sample = DHT11_samples[count & 1];
+	} while (DHT11_sampleCount != count);
+
+	return sample->sequence;
+}
+
+void DHT11_getStats(DHT11_Stats* stats)
+{
+	UInt key = Hwi_disable();
+
+	*stats = DHT11_stats;
+
+	Hwi_restore(key);
+}
+
+uint8_t DHT11_getTimeoutPhase(void)
+{
+	return DHT11_timeoutPhase;
+}
+
+uint8_t DHT11_getThreshold(void)
+{
+	return HRTimer_toMicros(DHT11_reading.threshold);
+}
@@ -0,0 +1,220 @@
+#ifndef __DHT11_H__
+#define __DHT11_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/knl/Clock.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "DHT11Decode.h"
+
+//
+//	Defines for the DHT11 sensor.
+//
+#define DHT11										PIN_ID(25)
+
+//
+//	Acquisition modes.
+//
+//	DHT11_MODE_POLL busy-waits on the pin for the whole frame.
+//	DHT11_MODE_EDGE timestamps every edge from the PIN interrupt
+//	callback and lets the calling task block until the frame ends.
+//	DHT11_MODE_CAPTURE routes the pin into a GPTimer edge-time
+//	capture and lets uDMA store every capture, the CPU only takes
+//	one interrupt when the whole frame has been transferred.
+//
+#define DHT11_MODE_POLL					0
+#define DHT11_MODE_EDGE					1
+#define DHT11_MODE_CAPTURE			2
+
+#ifndef DHT11_MODE
+#define DHT11_MODE							DHT11_MODE_EDGE
+#endif
+
+//
+//	Classify the bits with a threshold derived from every frame
+//	(see DHT11_THRESHOLD_AUTO) rather than the fixed DHT11_THRESHOLD,
+//	it tolerates long cables and sensors with a skewed clock. The
+//	sensors of DHT11Multi always use the fixed one.
+//
+#ifndef DHT11_ADAPTIVE
+#define DHT11_ADAPTIVE					1
+#endif
+
+//
+//	Timeout budgets per phase of the frame, in microseconds.
+//	Response: each of the three response levels (<= 40, 80, 80 us).
+//	Bit low:  the 50 us LOW gap before every bit.
+//	Bit high: the 26-28 us ("0") or 70 us ("1") HIGH pulse.
+//
+#define DHT11_TIMEOUT_RESPONSE_US	100
+#define DHT11_TIMEOUT_BIT_LOW_US	80
+#define DHT11_TIMEOUT_BIT_HIGH_US	100
+
+//
+//	Worst case duration of a frame (7.5 ms), a read never waits
+//	longer than this for the sensor once the start pulse ends.
+//
+#define DHT11_FRAME_TIMEOUT_US	((3 * DHT11_TIMEOUT_RESPONSE_US) + \
+								 (DHT11_NUM_BYTES * 8 * (DHT11_TIMEOUT_BIT_LOW_US + DHT11_TIMEOUT_BIT_HIGH_US)))
+
+//
+//	Retry policy. DHT11_pend() tries a failed transaction again up
+//	to DHT11_RETRIES times. The first retry waits DHT11_INTERVAL_MS,
+//	which the sensor needs anyway, every next one twice as long up
+//	to DHT11_RETRY_MAX_MS. DHT11_RETRIES=0 turns retries off.
+//
+#ifndef DHT11_RETRIES
+#define DHT11_RETRIES						2
+#endif
+
+#ifndef DHT11_RETRY_MAX_MS
+#define DHT11_RETRY_MAX_MS			4000
+#endif
+
+#if DHT11_RETRY_MAX_MS < DHT11_INTERVAL_MS
+#error "DHT11_RETRY_MAX_MS is shorter than the sensor's sampling interval"
+#endif
+
+//
+//	Wait before retry i (from 0), doubling from the sensor interval
+//	up to DHT11_RETRY_MAX_MS.
+//
+#define DHT11_backoffMs(i)			(((DHT11_INTERVAL_MS << (i)) < DHT11_RETRY_MAX_MS) ? \
+								 (DHT11_INTERVAL_MS << (i)) : DHT11_RETRY_MAX_MS)
+
+//
+//	Clock ticks covering at least the given time. A Clock started
+//	part way through a tick expires up to one tick early, which
+//	matters with a coarse Clock.tickPeriod.
+//
+#define DHT11_clockTicks(us)		((((us) + Clock_tickPeriod - 1) / Clock_tickPeriod) + 1)
+
+//
+//	Transaction counters since DHT11_init(): good reads, checksum
+//	errors, timeouts per frame phase, and retries. With CPULOAD they
+//	follow every CPU load report over the UART, as "dht11: reads N,
+//	retries N, checksum errors N, timeouts response N, bit low N,
+//	bit high N".
+//
+typedef struct DHT11_Stats
+{
+	uint32_t reads;
+	uint32_t retries;
+	uint32_t checksums;
+	uint32_t timeouts[DHT11_NUM_PHASES];
+} DHT11_Stats;
+
+//
+//	Result of the sample published until the first transaction
+//	completes, it has no reading.
+//
+#define DHT11_NO_SAMPLE					3
+
+//
+//	A published sample: the result of a transaction, the last good
+//	reading, the number of transactions so far (0 until the first
+//	completes) and the Clock tick it completed at.
+//
+typedef struct DHT11_Sample
+{
+	uint32_t      sequence;
+	uint32_t      timestamp;
+	uint8_t       result;
+	DHT11_Reading reading;
+} DHT11_Sample;
+
+//
+//	Construct the driver objects, call once before BIOS_start().
+//
+void DHT11_init(void);
+
+//
+//	Start a transaction without blocking, callable from Swi or task
+//	context. The start pulse, the sensor response and the frame
+//	are sequenced by Clock timeouts and pin/DMA interrupts. Returns
+//	FALSE when a transaction is already running, the last one
+//	started less than DHT11_INTERVAL_MS ago, or DHT11_pend() waits
+//	to retry one.
+//
+Bool DHT11_start(void);
+
+//
+//	Block the calling task until the running transaction completes,
+//	retrying it on errors as the retry policy says. Through the
+//	pause before a retry it owns the driver, DHT11_start() refuses
+//	other callers until the retry starts. The values, in tenths, are
+//	only written on DHT11_OK, either may be NULL when the caller
+//	takes the sample instead.
+//
+uint8_t DHT11_pend(int16_t* temperature, uint16_t* humidity);
+
+//
+//	Read the values through the sample cache, must be called from a
+//	task.
+//
+uint8_t DHT11_read(int16_t* temperature, uint16_t* humidity);
+
+//
+//	Sample cache front-end, for any number of tasks calling at any
+//	rate. Within DHT11_INTERVAL_MS of the last transaction it returns
+//	the cached sample. Past it the first caller runs a transaction,
+//	the callers arriving meanwhile wait for it and get its sample,
+//	so more clients never mean more reads. It retries a failed one
+//	as DHT11_pend() does, the others get the cached sample through
+//	the pauses. Returns the sample's result, age (may be NULL) gets
+//	its age in milliseconds. Callers of DHT11_start() must not share
+//	the driver with it.
+//
+uint8_t DHT11_get(DHT11_Sample* sample, uint32_t* age);
+
+//
+//	Copy the latest sample, callable from any context and by any
+//	number of readers. Neither blocks nor disables interrupts, a
+//	reader that preempts the publication never waits. Returns the
+//	sample's sequence, a new one means a new sample.
+//
+uint32_t DHT11_getSample(DHT11_Sample* sample);
+
+//
+//	Copy the transaction counters, callable from any context.
+//
+void DHT11_getStats(DHT11_Stats* stats);
+
+//
+//	Count a transaction result, with the phase of a timeout, or a
+//	retry, callable from any context. DHT11Multi counts its sensors
+//	into the driver's counters.
+//
+void DHT11_count(uint8_t result, uint8_t phase);
+void DHT11_countRetry(void);
+
+//
+//	Send the counters after every CPU load report, DHT11_init() and
+//	DHT11Multi_init() call it.
+//
+void DHT11_addReport(void);
+
+//
+//	Phase in which the last read timed out.
+//
+uint8_t DHT11_getTimeoutPhase(void);
+
+//
+//	Bit threshold of the last good frame, in microseconds.
+//
+uint8_t DHT11_getThreshold(void);
+
+#endif
@@ -0,0 +1,261 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include "DHT11Decode.h"
+
+#define DHT11_NUM_BITS					(DHT11_NUM_BYTES * 8)
+#define DHT11_CLUSTER_ITERATIONS	4
+
+uint8_t DHT11_edgePhase(uint8_t numEdges)
+{
+	if (numEdges < 3) return DHT11_PHASE_RESPONSE;
+
+	return ((numEdges - 3) % 2) ? DHT11_PHASE_BIT_HIGH : DHT11_PHASE_BIT_LOW;
+}
+
+//
+//	Threshold from the frame itself: starting half way between the
+//	shortest and longest pulse, it moves to the midpoint of the "0"
+//	and "1" means. A frame of one bit value has no two populations,
+//	9/10 of the mean 50 us LOW gap stands in then.
+//
+static uint32_t DHT11_cluster(const uint32_t* high, const uint32_t* low)
+{
+	uint32_t lowSum = 0, min = 0xFFFFFFFF, max = 0, reference = 0;
+	uint32_t threshold = 0, next = 0, sum0 = 0, sum1 = 0, n0 = 0, n1 = 0;
+	uint8_t  i = 0, j = 0;
+
+	for (i = 0; i < DHT11_NUM_BITS; i++)
+	{
+		lowSum += low[i];
+		if (high[i] < min) min = high[i];
+		if (high[i] > max) max = high[i];
+	}
+
+	reference = ((lowSum / DHT11_NUM_BITS) * 9) / 10;
+	if ((max - min) < (reference / 2)) return reference;
+
+	threshold = min + ((max - min) / 2);
+
+	for (j = 0; j < DHT11_CLUSTER_ITERATIONS; j++)
+	{
+		sum0 = sum1 = n0 = n1 = 0;
+
+		for (i = 0; i < DHT11_NUM_BITS; i++)
+		{
+			if (high[i] > threshold)
+			{
+				sum1 += high[i];
+				n1++;
+			}
+			else
+			{
+				sum0 += high[i];
+				n0++;
+			}
+		}
+
+		//
+		//	Real widths keep both populations non-empty, garbage ones
+		//	can overflow the sums.
+		//
+		if (!n0 || !n1) break;
+
+		next = ((sum0 / n0) + (sum1 / n1)) / 2;
+		if (next == threshold) break;
+
+		threshold = next;
+	}
+
+	return threshold;
+}
+
+uint8_t DHT11_decode(const uint32_t* edges, uint8_t numEdges, uint32_t mask, uint32_t threshold, DHT11_Reading* reading)
+{
+	uint32_t high[DHT11_NUM_BITS], low[DHT11_NUM_BITS];
+	uint8_t  bytes[DHT11_NUM_BYTES] = { 0 };
+	uint8_t  i = 0, bit = 0, checkSum = 0;
+
+	if (numEdges < DHT11_NUM_EDGES) return DHT11_ERROR_TIMEOUT;
+
+	//
+	//	Edges 0 to 2 are the response, then every bit is a rising
+	//	edge followed by a falling edge: the LOW gap of bit i ends at
+	//	edge 3 + 2i and its HIGH pulse at edge 4 + 2i. The mask
+	//	handles timestamps narrower than 32 bits.
+	//
+	for (i = 0; i < DHT11_NUM_BITS; i++)
+	{
+		low[i]  = (edges[3 + (2 * i)] - edges[2 + (2 * i)]) & mask;
+		high[i] = (edges[4 + (2 * i)] - edges[3 + (2 * i)]) & mask;
+	}
+
+	if (threshold == DHT11_THRESHOLD_AUTO) threshold = DHT11_cluster(high, low);
+
+	//
+	//	The HIGH pulse width decides the bit value, MSB first.
+	//
+	for (i = 0; i < DHT11_NUM_BITS; i++)
+	{
+		bit = (high[i] > threshold);
+		bytes[i / 8] |= (bit << (7 - (i % 8)));
+	}
+
+	//
+	//	Checksum will overflow automatically.
+	//
+	for (i = 0; i < (DHT11_NUM_BYTES - 1); i++) checkSum += bytes[i];
+	if (checkSum != bytes[DHT11_NUM_BYTES - 1]) return DHT11_ERROR_CHECKSUM;
+
+	for (i = 0; i < DHT11_NUM_BYTES; i++) reading->bytes[i] = bytes[i];
+	reading->humidity    = DHT11_HUMIDITY(bytes);
+	reading->temperature = DHT11_TEMPERATURE(bytes);
+	reading->threshold   = threshold;
+
+	return DHT11_OK;
+}
+
+//
+//	Add a value to the lanes of a bit-sliced counter, ripple carry
+//	across the slices. Returns the lanes that overflowed.
+//
+static uint32_t DHT11_lanesAdd(uint32_t* counter, uint8_t numBits, uint32_t lanes, uint32_t value)
+{
+	uint32_t carry = 0, addend = 0, sum = 0;
+	uint8_t  i = 0;
+
+	for (i = 0; i < numBits; i++)
+	{
+		addend     = ((value >> i) & 1) ? lanes : 0;
+		sum        = counter[i] ^ addend ^ carry;
+		carry      = (counter[i] & addend) | (carry & (counter[i] ^ addend));
+		counter[i] = sum;
+	}
+
+	return carry;
+}
+
+//
+//	Lanes of a bit-sliced counter above a value, compared from the
+//	top slice down.
+//
+static uint32_t DHT11_lanesAbove(const uint32_t* counter, uint8_t numBits, uint32_t value)
+{
+	uint32_t above = 0, equal = 0xFFFFFFFF;
+	uint8_t  i = numBits;
+
+	while (i--)
+	{
+		if ((value >> i) & 1)
+		{
+			equal &= counter[i];
+		}
+		else
+		{
+			above |= equal & counter[i];
+			equal &= ~counter[i];
+		}
+	}
+
+	return above;
+}
+
+void DHT11_lanesInit(DHT11_Lanes* lanes, uint32_t mask, uint32_t time, uint32_t threshold)
+{
+	uint8_t i = 0;
+
+	lanes->mask      = mask;
+	lanes->level     = mask;
+	lanes->done      = 0;
+	lanes->time      = time;
+	lanes->threshold = threshold >> DHT11_LANE_SHIFT;
+
+	for (i = 0; i < DHT11_LANE_WIDTH_BITS; i++) lanes->width[i] = 0;
+	for (i = 0; i < DHT11_LANE_FALLS_BITS; i++) lanes->falls[i] = 0;
+	for (i = 0; i < DHT11_NUM_BITS; i++) lanes->bits[i]  = 0;
+}
+
+uint32_t DHT11_lanesStep(DHT11_Lanes* lanes, uint32_t word, uint32_t time)
+{
+	uint32_t elapsed = ((time >> DHT11_LANE_SHIFT) - (lanes->time >> DHT11_LANE_SHIFT)) & (0xFFFFFFFF >> DHT11_LANE_SHIFT);
+	uint32_t active  = lanes->mask & ~lanes->done;
+	uint32_t rising = 0, falling = 0, ones = 0, overflow = 0;
+	uint8_t  i = 0;
+
+	word &= lanes->mask;
+	lanes->time = time;
+
+	//
+	//	The lanes that were high stayed so until this sample, a width
+	//	past the counter range sticks at its top.
+	//
+	if (elapsed > ((1 << DHT11_LANE_WIDTH_BITS) - 1)) elapsed = (1 << DHT11_LANE_WIDTH_BITS) - 1;
+
+	overflow = DHT11_lanesAdd(lanes->width, DHT11_LANE_WIDTH_BITS, lanes->level & active, elapsed);
+	for (i = 0; i < DHT11_LANE_WIDTH_BITS; i++) lanes->width[i] |= overflow;
+
+	rising  = ~lanes->level & word & active;
+	falling = lanes->level & ~word & active;
+	lanes->level = word;
+
+	//
+	//	A falling edge ends a HIGH pulse, shift its class in. Most
+	//	samples see no edge at all.
+	//
+	if (falling)
+	{
+		ones = DHT11_lanesAbove(lanes->width, DHT11_LANE_WIDTH_BITS, lanes->threshold) & falling;
+
+		for (i = DHT11_NUM_BITS - 1; i > 0; i--) lanes->bits[i] = (lanes->bits[i] & ~falling) | (lanes->bits[i - 1] & falling);
+		lanes->bits[0] = (lanes->bits[0] & ~falling) | ones;
+
+		DHT11_lanesAdd(lanes->falls, DHT11_LANE_FALLS_BITS, falling, 1);
+		lanes->done |= DHT11_lanesAbove(lanes->falls, DHT11_LANE_FALLS_BITS, DHT11_LANE_NUM_FALLS - 1);
+	}
+
+	//
+	//	A rising edge starts the next HIGH pulse.
+	//
+	if (rising)
+	{
+		for (i = 0; i < DHT11_LANE_WIDTH_BITS; i++) lanes->width[i] &= ~rising;
+	}
+
+	return lanes->done;
+}
+
+uint8_t DHT11_lanesDecode(const DHT11_Lanes* lanes, uint8_t lane, uint8_t* numEdges, DHT11_Reading* reading)
+{
+	uint8_t bytes[DHT11_NUM_BYTES] = { 0 };
+	uint8_t i = 0, falls = 0, checkSum = 0;
+
+	for (i = 0; i < DHT11_LANE_FALLS_BITS; i++) falls |= ((lanes->falls[i] >> lane) & 1) << i;
+
+	//
+	//	Every falling edge but the first follows a rising one, the
+	//	line may have risen again since the last.
+	//
+	*numEdges = falls ? ((2 * falls) - 1 + ((lanes->level >> lane) & 1)) : 0;
+
+	if (!((lanes->done >> lane) & 1)) return DHT11_ERROR_TIMEOUT;
+
+	//
+	//	The first bit of the frame went in 40 pulses ago.
+	//
+	for (i = 0; i < DHT11_NUM_BITS; i++)
+	{
+		bytes[i / 8] |= ((lanes->bits[DHT11_NUM_BITS - 1 - i] >> lane) & 1) << (7 - (i % 8));
+	}
+
+	for (i = 0; i < (DHT11_NUM_BYTES - 1); i++) checkSum += bytes[i];
+	if (checkSum != bytes[DHT11_NUM_BYTES - 1]) return DHT11_ERROR_CHECKSUM;
+
+	for (i = 0; i < DHT11_NUM_BYTES; i++) reading->bytes[i] = bytes[i];
+	reading->humidity    = DHT11_HUMIDITY(bytes);
+	reading->temperature = DHT11_TEMPERATURE(bytes);
+	reading->threshold   = lanes->threshold << DHT11_LANE_SHIFT;
+
+	return DHT11_OK;
+}
@@ -0,0 +1,143 @@
+#ifndef __DHT11DECODE_H__
+#define __DHT11DECODE_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include "DHT11Sensor.h"
+
+//
+//	Result codes.
+//
+#define DHT11_OK								0
+#define DHT11_ERROR_TIMEOUT			1
+#define DHT11_ERROR_CHECKSUM		2
+
+//
+//	Frame format: 5 bytes, MSB first, a bit is "1" when its HIGH
+//	pulse is longer than the threshold (in microseconds).
+//
+#define DHT11_NUM_BYTES					5
+#define DHT11_THRESHOLD					45
+
+//
+//	Pass as the threshold to derive it from every frame instead:
+//	the HIGH pulses are split into a short and a long population and
+//	the cut-off is the midpoint of their means, so a slow edge on a
+//	long cable or a skewed sensor clock moves it along with the
+//	pulses.
+//
+#define DHT11_THRESHOLD_AUTO		0
+
+//
+//	Edges in a frame: response low/high (3 edges) plus
+//	a rising and a falling edge for each of the 40 bits.
+//
+#define DHT11_NUM_EDGES					(3 + (DHT11_NUM_BYTES * 8 * 2))
+
+//
+//	Frame phases, reported for the last DHT11_ERROR_TIMEOUT.
+//
+#define DHT11_PHASE_RESPONSE		0
+#define DHT11_PHASE_BIT_LOW			1
+#define DHT11_PHASE_BIT_HIGH		2
+#define DHT11_NUM_PHASES				3
+
+typedef struct DHT11_Reading
+{
+	//
+	//	Values in tenths, decoded as the sensor family says
+	//	(DHT11Sensor.h), and the bytes they came from.
+	//
+	uint16_t humidity;
+	int16_t  temperature;
+	uint8_t  bytes[DHT11_NUM_BYTES];
+
+	//
+	//	Threshold the frame was decoded with, in timer ticks.
+	//
+	uint32_t threshold;
+} DHT11_Reading;
+
+//
+//	Decode a frame from its edge timestamps. Pure function: no pin
+//	access and no shared state, safe from any context.
+//
+//	numEdges  edges captured, fewer than DHT11_NUM_EDGES is a timeout.
+//	mask      timestamp width, 0xFFFFFFFF for a 32 bit timer.
+//	threshold "1"/"0" cut-off in timer ticks, or DHT11_THRESHOLD_AUTO.
+//
+//	The reading is only written on DHT11_OK.
+//
+uint8_t DHT11_decode(const uint32_t* edges, uint8_t numEdges, uint32_t mask, uint32_t threshold, DHT11_Reading* reading);
+
+//
+//	Phase the frame was in after the given number of edges.
+//
+uint8_t DHT11_edgePhase(uint8_t numEdges);
+
+//
+//	Bit-parallel decoder for sensors sampled together from one port,
+//	one lane per port bit. Every sample of the port word is folded
+//	in as it is taken, all lanes at once: the state holds its
+//	counters bit-sliced, word i carrying bit i of every lane, so one
+//	logic operation steps up to 32 sensors.
+//
+//	Time is counted in quanta of 2^DHT11_LANE_SHIFT timer ticks
+//	(2.7 us at 48 MHz), from the timestamp of every sample. A HIGH
+//	pulse above the threshold is a "1", the 42nd falling edge (two
+//	for the response, one per bit) completes a lane's frame.
+//
+#define DHT11_LANE_SHIFT				7
+#define DHT11_LANE_WIDTH_BITS		5
+#define DHT11_LANE_FALLS_BITS		6
+#define DHT11_LANE_NUM_FALLS		(2 + (DHT11_NUM_BYTES * 8))
+
+typedef struct DHT11_Lanes
+{
+	//
+	//	Lanes decoded, their levels at the last sample and the ones
+	//	with a complete frame.
+	//
+	uint32_t mask;
+	uint32_t level;
+	uint32_t done;
+
+	//
+	//	Timestamp of the last sample, and the threshold in quanta.
+	//
+	uint32_t time;
+	uint32_t threshold;
+
+	//
+	//	Bit-sliced, per lane: length of the running HIGH level in
+	//	quanta (saturating), falling edges so far, and the last 40
+	//	pulses classified, the latest in word 0.
+	//
+	uint32_t width[DHT11_LANE_WIDTH_BITS];
+	uint32_t falls[DHT11_LANE_FALLS_BITS];
+	uint32_t bits[DHT11_NUM_BYTES * 8];
+} DHT11_Lanes;
+
+//
+//	Start decoding the lanes in mask, with the lines just released
+//	(high) at the given timestamp. The threshold is in timer ticks.
+//
+void DHT11_lanesInit(DHT11_Lanes* lanes, uint32_t mask, uint32_t time, uint32_t threshold);
+
+//
+//	Fold in a sample of the port taken at the given timestamp, 32
+//	bit timer. Returns the lanes with a complete frame.
+//
+uint32_t DHT11_lanesStep(DHT11_Lanes* lanes, uint32_t word, uint32_t time);
+
+//
+//	Decode the frame of one lane (its port bit), as DHT11_decode().
+//	A lane short of a complete frame times out, numEdges gets the
+//	edges it saw for DHT11_edgePhase().
+//
+uint8_t DHT11_lanesDecode(const DHT11_Lanes* lanes, uint8_t lane, uint8_t* numEdges, DHT11_Reading* reading);
+
+#endif
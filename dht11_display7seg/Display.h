@@ -0,0 +1,174 @@
+#ifndef __DISPLAY_H__
+#define __DISPLAY_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+//
+//	Multiplexed seven segment display engine. The digits are lit one
+//	at a time for a dwell each, every refresh writes one precomputed
+//	port word holding the segments and the digit enables.
+//
+#define DISPLAY_NUM_SEGMENTS		7
+#define DISPLAY_MAX_DIGITS			8
+
+//
+//	Refresh backends.
+//
+//	DISPLAY_MODE_CLOCK writes the next digit from a Clock Swi every
+//	dwell.
+//	DISPLAY_MODE_DMA lets a GPTimer trigger uDMA every dwell, the CPU
+//	only takes an interrupt every DISPLAY_DMA_LENGTH dwells to re-arm
+//	the ping-pong and when the displayed value changes.
+//	DISPLAY_MODE_TIMER writes the next digit from a GPTimer Hwi every
+//	dwell. It doesn't depend on the Clock tick and only other Hwis
+//	delay it, the Hwi measures its own latency.
+//
+#define DISPLAY_MODE_CLOCK			0
+#define DISPLAY_MODE_DMA				1
+#define DISPLAY_MODE_TIMER			2
+
+#ifndef DISPLAY_MODE
+#define DISPLAY_MODE						DISPLAY_MODE_CLOCK
+#endif
+
+//
+//	Brightness. With DISPLAY_PWM the digit enables are gated by a
+//	GPTimer PWM output, the refresh routes it to the lit digit and a
+//	dwell holds a whole number of PWM periods, so every digit gets
+//	the same on time. The uDMA refresh runs at full brightness.
+//
+#ifndef DISPLAY_PWM
+#define DISPLAY_PWM							(DISPLAY_MODE != DISPLAY_MODE_DMA)
+#endif
+
+#define DISPLAY_BRIGHTNESS_LEVELS	8
+
+//
+//	Current of one lit segment in microamps, the segment pins are
+//	PIN_DRVSTR_MIN (2 mA).
+//
+#define DISPLAY_SEGMENT_CURRENT_UA	2000
+
+//
+//	Segment polarity. A common cathode module lights a segment with
+//	its pin HIGH, a common anode one with its pin LOW.
+//
+#define DISPLAY_COMMON_CATHODE	0
+#define DISPLAY_COMMON_ANODE		1
+
+//
+//	Slowest full scan of all digits that doesn't flicker, slower
+//	scan rates are raised to it.
+//
+#define DISPLAY_MIN_SCAN_HZ			60
+
+typedef struct Display_Params
+{
+	//
+	//	Segment pins A to G, and the digit enable pins, most
+	//	significant digit first.
+	//
+	PIN_Id  segmentPins[DISPLAY_NUM_SEGMENTS];
+	PIN_Id  digitPins[DISPLAY_MAX_DIGITS];
+	uint8_t numDigits;
+
+	uint8_t polarity;
+
+	//
+	//	Digit enables that drive the common pin directly are active
+	//	LOW on a common cathode module, ones switching a transistor
+	//	are usually active HIGH.
+	//
+	Bool    digitActiveLow;
+
+	//
+	//	Full scans of all digits per second, every digit stays lit
+	//	for 1 / (scanHz * numDigits). 0 is DISPLAY_MIN_SCAN_HZ.
+	//
+	uint32_t scanHz;
+
+	//
+	//	Brightness level at start, and the current of one lit segment
+	//	for Display_getCurrent().
+	//
+	uint8_t  brightness;
+	uint32_t segmentCurrentUa;
+} Display_Params;
+
+void Display_Params_init(Display_Params* params);
+
+//
+//	Open the pins and start the refresh with a blank display. Call
+//	once after PIN_init() and before BIOS_start().
+//
+void Display_init(const Display_Params* params);
+
+//
+//	Show new segments, one mask per digit, most significant digit
+//	first. Masks are built from _BV(segment pin), like the glyphs.
+//	Renders the port words once, must be called from a task.
+//
+void Display_write(const uint32_t* segments);
+
+//
+//	Blank the display and stop the refresh, and start it again. While
+//	off no timer runs for the display and the device can enter standby.
+//	Display_write() still takes new segments, they show once on. Must
+//	be called from a task.
+//
+void Display_off(void);
+void Display_on(void);
+Bool Display_isOn(void);
+
+//
+//	Dwell in use, in microseconds.
+//
+uint32_t Display_getDwell(void);
+
+//
+//	Refresh statistics. Latency runs from the timer timeout to the
+//	refresh Hwi, jitter is the largest change of latency between two
+//	refreshes, i.e. the worst error of a dwell. Both are measured in
+//	DISPLAY_MODE_TIMER only and read 0 otherwise. A CPULOAD build
+//	sends them after every CPU load report.
+//
+typedef struct Display_Stats
+{
+	uint32_t refreshes;
+	uint32_t minLatencyNs;
+	uint32_t meanLatencyNs;
+	uint32_t maxLatencyNs;
+	uint32_t maxJitterNs;
+} Display_Stats;
+
+void Display_getStats(Display_Stats* stats);
+void Display_resetStats(void);
+
+//
+//	Brightness level, 0 (dimmest) to DISPLAY_BRIGHTNESS_LEVELS - 1
+//	(full). Takes effect from the next PWM period.
+//
+void    Display_setBrightness(uint8_t level);
+uint8_t Display_getBrightness(void);
+
+//
+//	Duty of a brightness level in per mille, 1000 at every level
+//	without DISPLAY_PWM. The current is the average the display
+//	draws at that level with all segments lit, in microamps. One
+//	digit is lit at a time, the number of digits doesn't change it.
+//
+uint16_t Display_getDuty(uint8_t level);
+uint32_t Display_getCurrent(uint8_t level);
+
+#endif
@@ -0,0 +1,52 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include "Segments.h"
+#include "Glyph.h"
+
+//
+//	Bitwise operations.
+//
+#define _BV(bit)				(1 << (bit))
+
+//
+//	Segment mask of a glyph from its lit segments, A to G. Constant
+//	expression, the table below is computed by the compiler.
+//
+#define GLYPH(a, b, c, d, e, f, g)	(((a) ? _BV(SEGMENT_A) : 0) | \
+                                   	 ((b) ? _BV(SEGMENT_B) : 0) | \
+                                   	 ((c) ? _BV(SEGMENT_C) : 0) | \
+                                   	 ((d) ? _BV(SEGMENT_D) : 0) | \
+                                   	 ((e) ? _BV(SEGMENT_E) : 0) | \
+                                   	 ((f) ? _BV(SEGMENT_F) : 0) | \
+                                   	 ((g) ? _BV(SEGMENT_G) : 0))
+
+const uint32_t Glyph_table[GLYPH_COUNT] =
+{
+	GLYPH(1, 1, 1, 1, 1, 1, 0),		//	0
+	GLYPH(0, 1, 1, 0, 0, 0, 0),		//	1
+	GLYPH(1, 1, 0, 1, 1, 0, 1),		//	2
+	GLYPH(1, 1, 1, 1, 0, 0, 1),		//	3
+	GLYPH(0, 1, 1, 0, 0, 1, 1),		//	4
+	GLYPH(1, 0, 1, 1, 0, 1, 1),		//	5
+	GLYPH(1, 0, 1, 1, 1, 1, 1),		//	6
+	GLYPH(1, 1, 1, 0, 0, 0, 0),		//	7
+	GLYPH(1, 1, 1, 1, 1, 1, 1),		//	8
+	GLYPH(1, 1, 1, 1, 0, 1, 1),		//	9
+	GLYPH(1, 1, 1, 0, 1, 1, 1),		//	A
+	GLYPH(0, 0, 1, 1, 1, 1, 1),		//	b
+	GLYPH(1, 0, 0, 1, 1, 1, 0),		//	C
+	GLYPH(0, 1, 1, 1, 1, 0, 1),		//	d
+	GLYPH(1, 0, 0, 1, 1, 1, 1),		//	E
+	GLYPH(1, 0, 0, 0, 1, 1, 1),		//	F
+	GLYPH(0, 0, 0, 0, 0, 0, 1),		//	minus
+	GLYPH(1, 1, 0, 0, 0, 1, 1),		//	degree
+	GLYPH(0, 0, 0, 0, 0, 0, 0),		//	blank
+	GLYPH(0, 0, 0, 0, 1, 0, 1),		//	r
+	GLYPH(0, 1, 1, 0, 1, 1, 1),		//	H
+	GLYPH(0, 0, 1, 0, 0, 0, 0),		//	i
+	GLYPH(0, 0, 0, 1, 1, 1, 0),		//	L
+	GLYPH(0, 0, 1, 1, 1, 0, 1),		//	o
+};
@@ -0,0 +1,38 @@
+#ifndef __HRTIMER_H__
+#define __HRTIMER_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+//
+//	High resolution timestamps from a free running 32 bit GPTimer
+//	clocked at 48 MHz, wraps after ~89 s. Differences of two
+//	timestamps are valid across the wrap when taken as uint32_t.
+//
+#define HRTIMER_TICKS_PER_US		48
+
+#define HRTimer_toMicros(ticks)	((ticks) / HRTIMER_TICKS_PER_US)
+#define HRTimer_fromMicros(us)	((us) * HRTIMER_TICKS_PER_US)
+
+//
+//	Open the timer, call once before BIOS_start(). It starts
+//	stopped.
+//
+void HRTimer_init(void);
+
+//
+//	Run the timer while timestamps are taken. A running GPTimer keeps
+//	the device out of standby, stop it between uses. The count holds
+//	while stopped.
+//
+void HRTimer_start(void);
+void HRTimer_stop(void);
+
+//
+//	Current timestamp, callable from any context.
+//
+uint32_t HRTimer_now(void);
+
+#endif
@@ -15,52 +15,72 @@
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Task.h>
-#include <ti/sysbios/knl/Swi.h>
 //
 //	TI-RTOS Header files.
 //
 #include <ti/drivers/PIN.h>
 #include <ti/drivers/Power.h>
+#include <ti/drivers/UART.h>
+
+#include <Board.h>
+
+#include "DHT11.h"
+#include "HRTimer.h"
+#include "Display.h"
+#include "Segments.h"
+#include "Glyph.h"
+#include "CpuLoad.h"
+#include "Profile.h"
 
 //
-//	Bitwise operations.
+//	Defines for the seven segment display, the segment pins are in
+//	Segments.h.
 //
-#define _BV(bit)				(1 << (bit))
+#define DIGIT_UNITS							PIN_ID(27)
+#define DIGIT_TENS							PIN_ID(26)
+
+#define DISPLAY_NUM_DIGITS			2
 
 //
-//	Defines for the seven segment display.
+//	Default task stack size.
 //
-#define SEGMENT_A								PIN_ID(28)
-#define SEGMENT_B								PIN_ID(30)
-#define SEGMENT_C								PIN_ID(24)
-#define SEGMENT_D								PIN_ID(22)
-#define SEGMENT_E								PIN_ID(23)
-#define SEGMENT_F								PIN_ID(29)
-#define SEGMENT_G								PIN_ID(21)
+#define STACK_SIZE							512
 
-#define DIGIT_UNITS							PIN_ID(27)
-#define DIGIT_TENS							PIN_ID(26)
+//
+//	Clock ticks of a time in milliseconds, whatever the .cfg sets
+//	Clock.tickPeriod to.
+//
+#define MS_TO_TICKS(ms)					(((ms) * 1000) / Clock_tickPeriod)
 
 //
-//	Defines for the DHT11 sensor.
+//	Time between two samples, the sensor family sets a minimum. A
+//	shorter period would have DHT11_start() skip every other request.
 //
-#define DHT11	            			PIN_ID(25)
-#define DHT11_OK								0
-#define DHT11_ERROR_TIMEOUT			1
-#define DHT11_ERROR_CHECKSUM		2
-#define DHT11_NUM_BYTES					5
-#define DHT11_THRESHOLD					45
+#define SAMPLE_PERIOD_MS				3000
+
+#if SAMPLE_PERIOD_MS < DHT11_INTERVAL_MS
+#error "SAMPLE_PERIOD_MS is shorter than the sensor's sampling interval"
+#endif
 
 //
-//	General logic states.
+//	Whole units of a value in tenths, rounded half away from zero.
 //
-#define HIGH										1
-#define LOW											0
+#define TENTHS_TO_UNITS(value)	(((value) + (((value) < 0) ? -5 : 5)) / 10)
 
 //
-//	Default task stack size.
+//	Display power modes. The display refresh runs on a GPTimer, which
+//	keeps the device out of standby while the display is lit:
 //
-#define STACK_SIZE							512
+//	POWER_MODE_ON keeps the display lit.
+//	POWER_MODE_BLINK shows every reading for BLINK_MS, the device
+//	sleeps in standby until the next one.
+//	POWER_MODE_OFF only samples, the display stays dark.
+//
+#define POWER_MODE_ON						0
+#define POWER_MODE_BLINK				1
+#define POWER_MODE_OFF					2
+
+#define BLINK_MS								500
 
 //
 //	Task structure and stack.
@@ -71,19 +91,7 @@ Char DHT11_taskStack[STACK_SIZE];
 //
 //	Clock structure.
 //
-Clock_Struct Display_ClkStruct;
-
-//
-//	PIN driver handle.
-//
-PIN_Handle DHT11_handle;
-PIN_State  DHT11_state;
-
-PIN_Handle Display_segmentHandle;
-PIN_State  Display_segmentState;
-
-PIN_Handle Display_digitHandle;
-PIN_State  Display_digitState;
+Clock_Struct DHT11_ClkStruct;
 
 //
 //	PIN module initial configuration table - I/O.
@@ -103,241 +111,104 @@ PIN_Config gpioInitTable[] =
 	PIN_TERMINATE
 };
 
-//
-//	Seven segment display pin configuration tables.
-//
-PIN_Config Display_semgmentTable[] =
-{
-	SEGMENT_A | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_B | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_C | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_D | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_E | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_F | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_G | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	PIN_TERMINATE
-};
-
-PIN_Config Display_digitTable[] =
-{
-	DIGIT_UNITS | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW  | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	DIGIT_TENS  | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	PIN_TERMINATE
-};
-
-//
-//	DHT11 pin configuration tables.
-//
-PIN_Config DHT11_outputTable[] =
-{
-	DHT11 | PIN_GPIO_OUTPUT_EN | PIN_GPIO_HIGH | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	PIN_TERMINATE
-};
-
-PIN_Config DHT11_inputTable[] =
-{
-	DHT11 | PIN_INPUT_EN | PIN_NOPULL,
-	PIN_TERMINATE
-};
-
-//
-//	Array of seven segment display numbers.
-//
-uint32_t displayNumber[] =
-{
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F)),
-	(_BV(SEGMENT_B) | _BV(SEGMENT_C)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-};
+uint8_t powerMode = POWER_MODE_ON;
 
-uint8_t temperature = 0, humidity = 0;
+CPULOAD_HANDLER(DHT11_taskLoad, "main", CPULOAD_TASK);
 
 //
-//	This clock function runs every 10 ms with the main
-//	purpose of refreshing the seven segment led display.
+//	Show a value on the display, "Hi" above 99 and "Lo" below -9.
+//	Must be called from a task.
 //
-void Display_Clock(UArg arg0)
+void showNumber(int16_t value)
 {
-	//
-	//	Get the tens and units digits of the temperature value.
-	//
-	uint8_t tens = (uint8_t)(temperature / 10);
-	uint8_t units = temperature - (tens * 10);
+	uint32_t segments[DISPLAY_NUM_DIGITS];
 
-	//
-	//	Toggle current display digit on.
-	//
-	PIN_setOutputValue(Display_digitHandle, DIGIT_TENS,  !PIN_getOutputValue(DIGIT_TENS));
-	PIN_setOutputValue(Display_digitHandle, DIGIT_UNITS, !PIN_getOutputValue(DIGIT_UNITS));
-
-	//
-	//	Refresh display value.
-	//
-	if (PIN_getOutputValue(DIGIT_UNITS))
+	if (value > 99)
+	{
+		segments[0] = Glyph_table[GLYPH_LETTER_H];
+		segments[1] = Glyph_table[GLYPH_LETTER_I];
+	}
+	else if (value < -9)
+	{
+		segments[0] = Glyph_table[GLYPH_LETTER_L];
+		segments[1] = Glyph_table[GLYPH_LETTER_O];
+	}
+	else if (value < 0)
 	{
-		PIN_setPortOutputValue(Display_segmentHandle, displayNumber[units]);
+		segments[0] = Glyph_table[GLYPH_MINUS];
+		segments[1] = Glyph_table[-value];
 	}
 	else
 	{
-		PIN_setPortOutputValue(Display_segmentHandle, displayNumber[tens]);
+		segments[0] = Glyph_table[value / 10];
+		segments[1] = Glyph_table[value % 10];
 	}
+
+	Display_write(segments);
 }
 
-uint8_t skipPulse(uint8_t state)
+//
+//	Show "Er" until the next good reading.
+//
+void showError(void)
 {
-	uint16_t loopCnt = 10000;
+	uint32_t segments[DISPLAY_NUM_DIGITS];
 
-	//
-	//	Loop until the passed state has been reached.
-	//
-	while (PIN_getInputValue(DHT11) == state)
-		if (loopCnt-- == 0) return DHT11_ERROR_TIMEOUT;
+	segments[0] = Glyph_table[GLYPH_LETTER_E];
+	segments[1] = Glyph_table[GLYPH_LETTER_R];
 
-	return DHT11_OK;
+	Display_write(segments);
 }
 
-uint8_t readSensor(void)
+//
+//	This clock function runs every SAMPLE_PERIOD_MS and starts a
+//	sensor transaction, the DHT11 driver sequences the rest.
+//
+void DHT11_Clock(UArg arg0)
 {
-	//
-	//	Allocate collection of pins based on DHT11_outputTable.
-	//
-	DHT11_handle = PIN_open(&DHT11_state, DHT11_outputTable);
-	if (!DHT11_handle) System_abort("Error allocating pins - DHT11_outputTable\n");
-
-	//
-	//	Data buffer.
-	//
- 	uint8_t bytes[DHT11_NUM_BYTES];
-	uint8_t i = 0, j = 0;
-
-	//
-	//	Zero out the data buffer.
-	//
-	for (i = 0; i < DHT11_NUM_BYTES; i++) bytes[i] = 0;
-
-	//
-	//	Request sample.
-	//
-	PIN_setOutputValue(DHT11_handle, DHT11, LOW);
-	//
-	//	Sleep for 18 ms.
-	//
-	Task_sleep(18000 / Clock_tickPeriod);
-
-	//
-	//	Deallocate pins to return to the initial configuration.
-	//
-	PIN_close(DHT11_handle);
-
-	//
-	//	Allocate collection of pins based on DHT11_inputTable.
-	//
-	DHT11_handle = PIN_open(&DHT11_state, DHT11_inputTable);
-	if (!DHT11_handle) System_abort("Error allocating pins - DHT11_inputTable\n");
-
-	//
-	//	Skip the following pulses.
-	//
-	if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-	if (skipPulse(LOW))  return DHT11_ERROR_TIMEOUT;
-	if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-
-	//
-	//	Disable Swi to prevent Display_Clock preemption.
-	//
-	UInt key = Swi_disable();
-
-	//
-	//	Read output - 40 bits => 5 bytes or timeout.
-	//
-	UInt32 lastTick = 0, width = 0;
-	for (i = 0; i < DHT11_NUM_BYTES; i++)
-	{
-		for (j = 0; j < 8; j++)
-		{
-			if (skipPulse(LOW))  return DHT11_ERROR_TIMEOUT;
-
-			lastTick = Clock_getTicks();
-
-			if (skipPulse(HIGH)) return DHT11_ERROR_TIMEOUT;
-
-			//
-			//	Calculate width of last HIGH pulse.
-			//
-			width = (Clock_getTicks() - lastTick) * Clock_tickPeriod;
-
-			//
-			//	Shift in the data, MSB first if width > threshold.
-			//
-			bytes[i] |= ((width > DHT11_THRESHOLD) << (7 - j));
-		}
-	}
-
-	//
-	//	Restore Swis.
-	//
-	Swi_restore(key);
-
-	//
-	//	Get the checksum and look an error.
-	//
-	uint8_t checkSum = 0;
-	for (i = 0; i < (DHT11_NUM_BYTES - 1); i++)
-	{
-		checkSum += bytes[i];
-	}
-	if (checkSum != bytes[4])
-	{
-		return DHT11_ERROR_CHECKSUM;
-	}
-
-	humidity    = bytes[0];
-	temperature = bytes[2];
-
-  //
-	//	Deallocate pins to return to the initial configuration.
-	//
-	PIN_close(DHT11_handle);
-
-	return DHT11_OK;
+	DHT11_start();
 }
 
 //
-//	This task functions runs an infinite loop where
-//	the temperature sensor (DHT11) is read every 3 ms.
+//	This task blocks until a transaction completes and shows the
+//	sample it published, it never runs between samples.
 //
 void DHT11_task(UArg arg0, UArg arg1)
 {
-	uint32_t lastTick = 0;
-	uint32_t delayTime = (3000000 / Clock_tickPeriod);
+	DHT11_Sample sample;
 
 	while(1)
 	{
-		//
-		//	Refresh the temperature on the display every 3 seconds.
-		//
-		if ((Clock_getTicks()  - lastTick) > delayTime)
+		DHT11_pend(NULL, NULL);
+		DHT11_getSample(&sample);
+
+		CpuLoad_begin(&DHT11_taskLoad);
+		if (sample.result == DHT11_OK)
+		{
+			showNumber(TENTHS_TO_UNITS(sample.reading.temperature));
+		}
+		else
+		{
+			showError();
+		}
+		CpuLoad_end(&DHT11_taskLoad);
+
+		if (powerMode == POWER_MODE_BLINK)
 		{
-			if (readSensor() != DHT11_OK)
-			{
-				PIN_close(DHT11_handle);
-			}
-			lastTick = Clock_getTicks();
+			Display_on();
+			Task_sleep(MS_TO_TICKS(BLINK_MS));
+			Display_off();
 		}
 	}
 }
 
 int main(void)
 {
-	Task_Params  DHT11_taskParams;
-	Clock_Params Display_clkParams;
+	Task_Params    DHT11_taskParams;
+	Clock_Params   DHT11_clkParams;
+	Display_Params displayParams;
+	UART_Params    uartParams;
+	UART_Handle    uart;
 
 	//
 	//	Power manager initialization.
@@ -353,20 +224,47 @@ int main(void)
 	}
 
 	//
-	//	Allocate collection of pins.
+	//	Seven segment display, tens then units.
 	//
-	Display_segmentHandle = PIN_open(&Display_segmentState, Display_semgmentTable);
-	if (!Display_segmentHandle)
-	{
-		System_abort("Error allocating Display_semgmentTable\n");
-	}
+	Display_Params_init(&displayParams);
+	displayParams.segmentPins[0] = SEGMENT_A;
+	displayParams.segmentPins[1] = SEGMENT_B;
+	displayParams.segmentPins[2] = SEGMENT_C;
+	displayParams.segmentPins[3] = SEGMENT_D;
+	displayParams.segmentPins[4] = SEGMENT_E;
+	displayParams.segmentPins[5] = SEGMENT_F;
+	displayParams.segmentPins[6] = SEGMENT_G;
+	displayParams.digitPins[0]   = DIGIT_TENS;
+	displayParams.digitPins[1]   = DIGIT_UNITS;
+	displayParams.numDigits      = DISPLAY_NUM_DIGITS;
+	Display_init(&displayParams);
+	showNumber(0);
+	if (powerMode != POWER_MODE_ON) Display_off();
+
+	//
+	//	High resolution timestamp and DHT11 driver initialization.
+	//
+	HRTimer_init();
+	DHT11_init();
 
-	Display_digitHandle = PIN_open(&Display_digitState, Display_digitTable);
-	if (!Display_digitHandle)
+	//
+	//	CPU load reports and profile dumps over the UART.
+	//
+	Board_initUART();
+	UART_Params_init(&uartParams);
+	uartParams.writeDataMode = UART_DATA_TEXT;
+	uartParams.readDataMode  = UART_DATA_TEXT;
+	uartParams.readEcho      = UART_ECHO_OFF;
+	uartParams.baudRate      = 115200;
+	uart = UART_open(Board_UART0, &uartParams);
+	if (!uart)
 	{
-		System_abort("Error allocating Display_digitTable\n");
+		System_abort("Error opening the UART\n");
 	}
 
+	CpuLoad_init(uart);
+	Profile_init(uart);
+
 	//
 	//	Construct DHT11 task thread.
 	//
@@ -376,12 +274,12 @@ int main(void)
 	Task_construct(&DHT11_taskStruct, (Task_FuncPtr)DHT11_task, &DHT11_taskParams, NULL);
 
 	//
-	//	Construct a periodic Clock Instance.
+	//	Construct the periodic sampling Clock Instance.
 	//
-	Clock_Params_init(&Display_clkParams);
-	Display_clkParams.period = 1000;
-	Display_clkParams.startFlag = TRUE;
-	Clock_construct(&Display_ClkStruct, (Clock_FuncPtr)Display_Clock, 1000, &Display_clkParams);
+	Clock_Params_init(&DHT11_clkParams);
+	DHT11_clkParams.period = MS_TO_TICKS(SAMPLE_PERIOD_MS);
+	DHT11_clkParams.startFlag = TRUE;
+	Clock_construct(&DHT11_ClkStruct, (Clock_FuncPtr)DHT11_Clock, DHT11_clkParams.period, &DHT11_clkParams);
 
   BIOS_start();
 
@@ -0,0 +1,318 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/UART.h>
+
+#include <driverlib/aon_rtc.h>
+
+#include "CpuLoad.h"
+#include "Cycles.h"
+
+#if CPULOAD
+
+//
+//	RTC compare value units, 1/65536 s.
+//
+#define CpuLoad_toMicros(time)	((uint32_t)(((uint64_t)(time) * 1000000) >> 16))
+#define CpuLoad_toCycles(time)	((uint32_t)(((uint64_t)(time) * CYCLES_PER_US * 1000000) >> 16))
+
+//
+//	Load in thousandths of a percent, printed as %u.%03u%%. A sensor
+//	read every few seconds takes tens of microseconds a second.
+//
+#define CpuLoad_share(time, elapsed)	((uint32_t)(((uint64_t)(time) * 100000) / (elapsed)))
+
+#define CPULOAD_STACK_SIZE			512
+
+//
+//	The load line and the lines of the reports added.
+//
+#define CPULOAD_REPORT_SIZE			((CPULOAD_MAX_REPORTS + 1) * CPULOAD_LINE_SIZE)
+
+static const char* const CpuLoad_typeNames[CPULOAD_NUM_TYPES] = { "hwi", "swi", "task" };
+
+static Task_Struct CpuLoad_taskStruct;
+static Char        CpuLoad_taskStack[CPULOAD_STACK_SIZE];
+
+static UART_Handle CpuLoad_uart;
+
+//
+//	UART write gate.
+//
+static Semaphore_Struct CpuLoad_writeSemStruct;
+static Semaphore_Handle CpuLoad_writeSem;
+
+static CpuLoad_ReportFxn CpuLoad_reports[CPULOAD_MAX_REPORTS];
+static uint8_t           CpuLoad_numReports;
+
+CPULOAD_HANDLER(CpuLoad_report, "cpuload", CPULOAD_TASK);
+
+//
+//	Handlers seen so far, the one running, and the cycle count when
+//	the time of the running one was last taken.
+//
+static CpuLoad_Handler* CpuLoad_handlers;
+static CpuLoad_Handler* CpuLoad_current;
+static uint32_t         CpuLoad_mark;
+
+//
+//	Start of the period on the RTC, and the cycles handlers took in
+//	it.
+//
+static uint32_t CpuLoad_start;
+static uint32_t CpuLoad_busy;
+
+//
+//	A busy stretch runs from the first handler after an Idle hook run
+//	to the end of the last one before the next. An interrupt between
+//	the hook and the sleep leaves the stretch open through the sleep,
+//	the end of the last handler closes it. Stretches are timed on the
+//	RTC, the cycle counter stops in the sleep.
+//
+static Bool     CpuLoad_stretching;
+static uint32_t CpuLoad_stretchStart;
+static uint32_t CpuLoad_stretchEnd;
+static uint32_t CpuLoad_maxStretch;
+
+static uint32_t CpuLoad_now(void)
+{
+	return Cycles_now();
+}
+
+static uint32_t CpuLoad_rtc(void)
+{
+	return AONRTCCurrentCompareValueGet();
+}
+
+//
+//	Charge the running handler up to now.
+//
+static void CpuLoad_charge(uint32_t now)
+{
+	if (!CpuLoad_current) return;
+
+	CpuLoad_current->time += now - CpuLoad_mark;
+	CpuLoad_current->run  += now - CpuLoad_mark;
+	CpuLoad_busy          += now - CpuLoad_mark;
+}
+
+void CpuLoad_begin(CpuLoad_Handler* handler)
+{
+	UInt key = Hwi_disable();
+	uint32_t now = CpuLoad_now();
+
+	if (!handler->linked)
+	{
+		handler->linked = TRUE;
+		handler->next   = CpuLoad_handlers;
+		CpuLoad_handlers = handler;
+	}
+
+	if (!CpuLoad_stretching)
+	{
+		CpuLoad_stretching   = TRUE;
+		CpuLoad_stretchStart = CpuLoad_rtc();
+	}
+
+	CpuLoad_charge(now);
+
+	handler->run     = 0;
+	handler->outer   = CpuLoad_current;
+	CpuLoad_current  = handler;
+	CpuLoad_mark     = now;
+
+	Hwi_restore(key);
+}
+
+void CpuLoad_end(CpuLoad_Handler* handler)
+{
+	UInt key = Hwi_disable();
+	uint32_t now = CpuLoad_now();
+
+	CpuLoad_charge(now);
+
+	if (handler->run > handler->maxRun) handler->maxRun = handler->run;
+
+	CpuLoad_current = handler->outer;
+	CpuLoad_mark    = now;
+
+	if (!CpuLoad_current) CpuLoad_stretchEnd = CpuLoad_rtc();
+
+	Hwi_restore(key);
+}
+
+void CpuLoad_idle(void)
+{
+	UInt key = Hwi_disable();
+
+	if (CpuLoad_stretching)
+	{
+		CpuLoad_stretching = FALSE;
+		if ((CpuLoad_stretchEnd - CpuLoad_stretchStart) > CpuLoad_maxStretch) CpuLoad_maxStretch = CpuLoad_stretchEnd - CpuLoad_stretchStart;
+	}
+
+	Hwi_restore(key);
+}
+
+//
+//	Format the report of the period ending now, and start the next
+//	one. Returns its length.
+//
+static Int CpuLoad_format(char* report)
+{
+	uint32_t types[CPULOAD_NUM_TYPES] = { 0 };
+	uint32_t now = 0, elapsed = 0, cycles = 0, load = 0, stretch = 0, share = 0, maxRun = 0;
+	CpuLoad_Handler* handler = NULL;
+	CpuLoad_Handler* busiest = NULL;
+	UInt key = 0;
+	Int  length = 0;
+	uint8_t i = 0;
+
+	key = Hwi_disable();
+
+	//
+	//	The handlers' cycles against the cycles of the period on the
+	//	RTC, the device may have slept through most of it.
+	//
+	now = CpuLoad_now();
+	CpuLoad_charge(now);
+	CpuLoad_mark = now;
+
+	now     = CpuLoad_rtc();
+	elapsed = now - CpuLoad_start;
+	cycles  = CpuLoad_toCycles(elapsed);
+	load    = CpuLoad_share(CpuLoad_busy, cycles);
+	stretch = CpuLoad_toMicros(CpuLoad_maxStretch);
+
+	for (handler = CpuLoad_handlers; handler; handler = handler->next)
+	{
+		types[handler->type] += handler->time;
+		if (!busiest || (handler->time > busiest->time)) busiest = handler;
+	}
+
+	if (busiest)
+	{
+		share  = CpuLoad_share(busiest->time, cycles);
+		maxRun = Cycles_toMicros(busiest->maxRun);
+	}
+
+	for (i = 0; i < CPULOAD_NUM_TYPES; i++) types[i] = CpuLoad_share(types[i], cycles);
+
+	//
+	//	Next period. The running handler (this task) keeps its run.
+	//
+	for (handler = CpuLoad_handlers; handler; handler = handler->next)
+	{
+		handler->time   = 0;
+		handler->maxRun = 0;
+	}
+	CpuLoad_start     += elapsed;
+	CpuLoad_busy       = 0;
+	CpuLoad_maxStretch = 0;
+
+	Hwi_restore(key);
+
+	length = System_sprintf(report, "load %u.%03u%%: %s %u.%03u%%, %s %u.%03u%%, %s %u.%03u%%",
+	                        load / 1000, load % 1000,
+	                        CpuLoad_typeNames[CPULOAD_HWI], types[CPULOAD_HWI] / 1000, types[CPULOAD_HWI] % 1000,
+	                        CpuLoad_typeNames[CPULOAD_SWI], types[CPULOAD_SWI] / 1000, types[CPULOAD_SWI] % 1000,
+	                        CpuLoad_typeNames[CPULOAD_TASK], types[CPULOAD_TASK] / 1000, types[CPULOAD_TASK] % 1000);
+
+	if (busiest)
+	{
+		length += System_sprintf(report + length, ", busiest %s %s %u.%03u%% max %u us",
+		                         CpuLoad_typeNames[busiest->type], busiest->name, share / 1000, share % 1000, maxRun);
+	}
+
+	length += System_sprintf(report + length, ", longest busy %u us\n", stretch);
+
+	for (i = 0; i < CpuLoad_numReports; i++) length += CpuLoad_reports[i](report + length);
+
+	return length;
+}
+
+static void CpuLoad_task(UArg arg0, UArg arg1)
+{
+	static char report[CPULOAD_REPORT_SIZE];
+	Int length = 0;
+
+	while (1)
+	{
+		Task_sleep((CPULOAD_REPORT_MS * 1000) / Clock_tickPeriod);
+
+		//
+		//	Only the formatting is load. The write blocks the task for
+		//	the time the report takes on the line, and the CPU is free
+		//	meanwhile.
+		//
+		CpuLoad_begin(&CpuLoad_report);
+		length = CpuLoad_format(report);
+		CpuLoad_end(&CpuLoad_report);
+
+		CpuLoad_write(CpuLoad_uart, report, length);
+	}
+}
+
+Int CpuLoad_write(UART_Handle uart, const void* buffer, size_t size)
+{
+	Int length = 0;
+
+	Semaphore_pend(CpuLoad_writeSem, BIOS_WAIT_FOREVER);
+	length = UART_write(uart, buffer, size);
+	Semaphore_post(CpuLoad_writeSem);
+
+	return length;
+}
+
+void CpuLoad_addReport(CpuLoad_ReportFxn fxn)
+{
+	if (CpuLoad_numReports == CPULOAD_MAX_REPORTS) System_abort("Too many CPU load reports\n");
+
+	CpuLoad_reports[CpuLoad_numReports++] = fxn;
+}
+
+void CpuLoad_init(UART_Handle uart)
+{
+	Semaphore_Params semParams;
+	Task_Params      taskParams;
+
+	CpuLoad_uart = uart;
+
+	Semaphore_Params_init(&semParams);
+	semParams.mode = Semaphore_Mode_BINARY;
+	Semaphore_construct(&CpuLoad_writeSemStruct, 1, &semParams);
+	CpuLoad_writeSem = Semaphore_handle(&CpuLoad_writeSemStruct);
+
+	Cycles_init();
+	CpuLoad_start = CpuLoad_rtc();
+
+	Task_Params_init(&taskParams);
+	taskParams.stackSize = CPULOAD_STACK_SIZE;
+	taskParams.stack     = CpuLoad_taskStack;
+	Task_construct(&CpuLoad_taskStruct, (Task_FuncPtr)CpuLoad_task, &taskParams, NULL);
+}
+
+#else
+
+void CpuLoad_idle(void)
+{
+}
+
+#endif
@@ -0,0 +1,779 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/hal/Hwi.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "Display.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+
+#if DISPLAY_MODE == DISPLAY_MODE_DMA
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+#include <ti/drivers/dma/UDMACC26XX.h>
+
+#include <inc/hw_memmap.h>
+#include <inc/hw_types.h>
+#include <inc/hw_gpt.h>
+#include <inc/hw_gpio.h>
+#include <driverlib/timer.h>
+#include <driverlib/udma.h>
+
+#include <Board.h>
+#endif
+
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+
+#include <Board.h>
+#endif
+
+#if DISPLAY_PWM
+#if DISPLAY_MODE == DISPLAY_MODE_DMA
+#error "DISPLAY_PWM needs the Clock or the timer refresh"
+#endif
+
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+
+#include <driverlib/ioc.h>
+
+#include <Board.h>
+#endif
+
+//
+//	Bitwise operations.
+//
+#define _BV(bit)				(1 << (bit))
+
+//
+//	GPTimers run from the 48 MHz system clock.
+//
+#define DISPLAY_TIMER_TICKS_PER_US	48
+
+//
+//	Display pins, segments and digits share one port so a single
+//	write switches both.
+//
+static PIN_Handle Display_handle;
+static PIN_State  Display_state;
+static PIN_Config Display_pinTable[DISPLAY_NUM_SEGMENTS + DISPLAY_MAX_DIGITS + 1];
+
+//
+//	Port bits of the segments, and the digit enable bits of every
+//	digit's port word (all other digits off).
+//
+static uint32_t Display_segmentMask;
+static uint32_t Display_segmentInvert;
+static uint32_t Display_digitWords[DISPLAY_MAX_DIGITS];
+
+//
+//	Port word with every segment and digit off.
+//
+static uint32_t Display_offWord;
+
+static uint8_t  Display_numDigits;
+static uint32_t Display_dwellUs;
+static PIN_Id   Display_digitPins[DISPLAY_MAX_DIGITS];
+static Bool     Display_digitActiveLow;
+
+//
+//	Brightness level, and the current of one lit segment.
+//
+static uint8_t  Display_brightness;
+static uint32_t Display_segmentCurrentUa;
+
+//
+//	Display frame buffers, the port word of every digit rendered
+//	once per write. The refresh shows the front frame, latched at
+//	the start of each scan so all digits come from the same write,
+//	and the task renders into the other one before flipping the
+//	index.
+//
+static uint32_t Display_frames[2][DISPLAY_MAX_DIGITS];
+static volatile uint8_t Display_front = 0;
+static volatile uint8_t Display_scan  = 0;
+static uint8_t Display_digit = 0;
+
+static volatile uint32_t Display_refreshes;
+
+//
+//	FALSE until Display_init() and between Display_off() and
+//	Display_on().
+//
+static Bool Display_lit = FALSE;
+
+#if DISPLAY_PWM
+//
+//	Brightness timer. Timer 0 is the uDMA refresh, 1 the DHT11
+//	capture and 2 the HRTimer, the B half of this one is the timer
+//	refresh. A dwell is DISPLAY_PWM_CYCLES PWM periods, at most
+//	16.7 ms / 16 which fits the 16 bit mode.
+//
+#define DISPLAY_PWM_TIMER				Board_GPTIMER3A
+#define DISPLAY_PWM_CYCLES			16
+
+//
+//	Duty of every brightness level in per mille. Each step doubles
+//	the on time, about the same perceived step.
+//
+static const uint16_t Display_duty[DISPLAY_BRIGHTNESS_LEVELS] =
+{
+	8, 16, 31, 63, 125, 250, 500, 1000
+};
+
+static GPTimerCC26XX_Handle Display_pwm;
+static int32_t              Display_pwmMux;
+static uint32_t             Display_pwmPeriod;
+
+//
+//	Digit the PWM output is routed to.
+//
+static uint8_t Display_pwmDigit = 0;
+
+//
+//	Set the on time of the brightness level. The PWM counts down
+//	from the load, its output is high until the match and low for
+//	the match + 1 ticks left. Active LOW digits are lit by the low
+//	part.
+//
+static void Display_pwmApply(void)
+{
+	uint32_t load = Display_pwmPeriod - 1, on = 0;
+
+	on = (Display_pwmPeriod * Display_duty[Display_brightness]) / 1000;
+	if (on < 1)    on = 1;
+	if (on > load) on = load;
+
+	GPTimerCC26XX_setMatchValue(Display_pwm, Display_digitActiveLow ? (on - 1) : (load - on));
+}
+
+//
+//	Open the brightness timer, Display_on() starts it.
+//
+static void Display_pwmOpen(void)
+{
+	GPTimerCC26XX_Params timerParams;
+
+	GPTimerCC26XX_Params_init(&timerParams);
+	timerParams.width          = GPT_CONFIG_16BIT;
+	timerParams.mode           = GPT_MODE_PWM;
+	timerParams.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+	Display_pwm = GPTimerCC26XX_open(DISPLAY_PWM_TIMER, &timerParams);
+	if (!Display_pwm) System_abort("Error opening display PWM timer\n");
+
+	Display_pwmMux    = GPTimerCC26XX_getPinMux(Display_pwm);
+	Display_pwmPeriod = (Display_dwellUs * DISPLAY_TIMER_TICKS_PER_US) / DISPLAY_PWM_CYCLES;
+
+	GPTimerCC26XX_setLoadValue(Display_pwm, Display_pwmPeriod - 1);
+	Display_pwmApply();
+}
+#endif
+
+#if DISPLAY_MODE != DISPLAY_MODE_DMA
+//
+//	Runs every dwell. Constant time, a single port write of a
+//	precomputed word whatever the number of digits.
+//
+//	With DISPLAY_PWM the words keep every digit off, the lit digit
+//	is handed back to its GPIO before the segments change and the
+//	next one gets the PWM output after, so no digit ever shows the
+//	other's segments.
+//
+PROFILE_REGION(Display_nextProfile, "Display_next");
+
+static void Display_next(void)
+{
+	Profile_begin(&Display_nextProfile);
+
+	if (Display_digit == 0) Display_scan = Display_front;
+
+#if DISPLAY_PWM
+	PINCC26XX_setMux(Display_handle, Display_digitPins[Display_pwmDigit], IOC_PORT_GPIO);
+#endif
+
+	PIN_setPortOutputValue(Display_handle, Display_frames[Display_scan][Display_digit]);
+
+#if DISPLAY_PWM
+	PINCC26XX_setMux(Display_handle, Display_digitPins[Display_digit], Display_pwmMux);
+	Display_pwmDigit = Display_digit;
+#endif
+
+	if (++Display_digit == Display_numDigits) Display_digit = 0;
+	Display_refreshes++;
+
+	Profile_end(&Display_nextProfile);
+}
+#endif
+
+#if DISPLAY_MODE == DISPLAY_MODE_CLOCK
+static Clock_Struct Display_clkStruct;
+
+CPULOAD_HANDLER(Display_cpuLoad, "display", CPULOAD_SWI);
+
+static void Display_clock(UArg arg0)
+{
+	CpuLoad_begin(&Display_cpuLoad);
+	Display_next();
+	CpuLoad_end(&Display_cpuLoad);
+}
+
+static void Display_start(void)
+{
+	Clock_Params clkParams;
+
+	Clock_Params_init(&clkParams);
+	clkParams.period    = Display_dwellUs / Clock_tickPeriod;
+	clkParams.startFlag = FALSE;
+	Clock_construct(&Display_clkStruct, (Clock_FuncPtr)Display_clock, clkParams.period, &clkParams);
+}
+
+static void Display_halt(void)
+{
+	Clock_stop(Clock_handle(&Display_clkStruct));
+}
+
+static void Display_run(void)
+{
+	Clock_start(Clock_handle(&Display_clkStruct));
+}
+
+#elif DISPLAY_MODE == DISPLAY_MODE_TIMER
+
+//
+//	Refresh timer, it times out every dwell. Without DISPLAY_PWM it
+//	is timer 0. With it the other half of the brightness timer,
+//	counting exactly DISPLAY_PWM_CYCLES PWM periods from the same
+//	clock and started along with the PWM, so the multiplex stays
+//	locked to the PWM at one interrupt a dwell. A 16 bit half counts
+//	up to 24 bits with its prescaler.
+//
+#if DISPLAY_PWM
+#define DISPLAY_TIMER						Board_GPTIMER3B
+#else
+#define DISPLAY_TIMER						Board_GPTIMER0A
+#endif
+
+static GPTimerCC26XX_Handle Display_timer;
+
+#define Display_toNs(ticks)			((uint32_t)(((uint64_t)(ticks) * 1000) / DISPLAY_TIMER_TICKS_PER_US))
+
+//
+//	Refresh latency, from the timeout to the Hwi reading the timer,
+//	in timer ticks. The change of latency between two refreshes is
+//	the error of the refresh period.
+//
+static uint32_t Display_minLatency = ~(uint32_t)0;
+static uint32_t Display_maxLatency;
+static uint32_t Display_maxJitter;
+static uint32_t Display_lastLatency;
+static uint64_t Display_sumLatency;
+static uint32_t Display_latencies;
+
+CPULOAD_HANDLER(Display_cpuLoad, "display", CPULOAD_HWI);
+
+static void Display_timerFxn(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask)
+{
+	uint32_t latency = 0, jitter = 0;
+
+	CpuLoad_begin(&Display_cpuLoad);
+
+	latency = GPTimerCC26XX_getFreeRunValue(handle);
+
+	Display_next();
+
+	if (latency < Display_minLatency) Display_minLatency = latency;
+	if (latency > Display_maxLatency) Display_maxLatency = latency;
+
+	if (Display_latencies)
+	{
+		jitter = (latency > Display_lastLatency) ? (latency - Display_lastLatency) : (Display_lastLatency - latency);
+		if (jitter > Display_maxJitter) Display_maxJitter = jitter;
+	}
+
+	Display_lastLatency = latency;
+	Display_sumLatency += latency;
+	Display_latencies++;
+
+	CpuLoad_end(&Display_cpuLoad);
+}
+
+static void Display_start(void)
+{
+	GPTimerCC26XX_Params timerParams;
+
+	GPTimerCC26XX_Params_init(&timerParams);
+#if DISPLAY_PWM
+	timerParams.width          = GPT_CONFIG_16BIT;
+#else
+	timerParams.width          = GPT_CONFIG_32BIT;
+#endif
+	timerParams.mode           = GPT_MODE_PERIODIC_UP;
+	timerParams.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+	Display_timer = GPTimerCC26XX_open(DISPLAY_TIMER, &timerParams);
+	if (!Display_timer) System_abort("Error opening display timer\n");
+
+#if DISPLAY_PWM
+	GPTimerCC26XX_setLoadValue(Display_timer, (Display_pwmPeriod * DISPLAY_PWM_CYCLES) - 1);
+#else
+	GPTimerCC26XX_setLoadValue(Display_timer, (Display_dwellUs * DISPLAY_TIMER_TICKS_PER_US) - 1);
+#endif
+
+	GPTimerCC26XX_registerInterrupt(Display_timer, Display_timerFxn, GPT_INT_TIMEOUT);
+}
+
+static void Display_halt(void)
+{
+	GPTimerCC26XX_stop(Display_timer);
+}
+
+static void Display_run(void)
+{
+	GPTimerCC26XX_start(Display_timer);
+}
+
+#elif DISPLAY_MODE == DISPLAY_MODE_DMA
+
+//
+//	Multiplex timer and the uDMA channel it triggers. A dwell is
+//	more than 16 bits of 48 MHz, the timer runs in 32 bit mode.
+//
+#define DISPLAY_TIMER						Board_GPTIMER0A
+#define DISPLAY_DMA_CH					UDMA_CHAN_TIMER0_A
+
+//
+//	Most transfers per ping-pong half, at most 1024. Both halves
+//	walk the whole table, trimmed to a multiple of the digits.
+//
+#define DISPLAY_DMA_LENGTH			256
+
+static GPTimerCC26XX_Handle Display_timer;
+static UDMACC26XX_Handle    Display_dma;
+static uint32_t             Display_timerBase;
+static uint16_t             Display_dmaLength;
+
+//
+//	uDMA control table entries, primary and alternate.
+//
+ALLOCATE_CONTROL_TABLE_ENTRY(Display_dmaControlTableEntry, DISPLAY_DMA_CH);
+ALLOCATE_CONTROL_TABLE_ENTRY(Display_dmaAltControlTableEntry, DISPLAY_DMA_CH | UDMA_ALT_SELECT);
+
+//
+//	Toggle table, copied into GPIO DOUTTGL one word per dwell.
+//	Entry k turns digit k's port word into the next digit's, so the
+//	transfers only flip display pins and never touch the DHT11 line
+//	or any other output sharing the GPIO bank.
+//
+static uint32_t Display_toggles[DISPLAY_DMA_LENGTH];
+
+CPULOAD_HANDLER(Display_cpuLoad, "display dma", CPULOAD_HWI);
+
+static void Display_arm(uint32_t select)
+{
+	uDMAChannelControlSet(UDMA0_BASE, DISPLAY_DMA_CH | select,
+	                      UDMA_SIZE_32 | UDMA_SRC_INC_32 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+	uDMAChannelTransferSet(UDMA0_BASE, DISPLAY_DMA_CH | select, UDMA_MODE_PINGPONG,
+	                       (void *)Display_toggles, (void *)(GPIO_BASE + GPIO_O_DOUTTGL31_0),
+	                       Display_dmaLength);
+}
+
+//
+//	GPTimer interrupt callback, only the DMA done event is enabled.
+//	The uDMA already moved on to the other half, re-arm this one.
+//
+static void Display_dmaCallback(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask)
+{
+	CpuLoad_begin(&Display_cpuLoad);
+
+	TimerIntClear(Display_timerBase, TIMER_TIMA_DMA);
+	UDMACC26XX_clearInterrupt(Display_dma, (1 << DISPLAY_DMA_CH));
+
+	if (uDMAChannelAttributeGet(UDMA0_BASE, DISPLAY_DMA_CH) & UDMA_ATTR_ALTSELECT)
+	{
+		Display_arm(UDMA_PRI_SELECT);
+	}
+	else
+	{
+		Display_arm(UDMA_ALT_SELECT);
+	}
+
+	CpuLoad_end(&Display_cpuLoad);
+}
+
+//
+//	Point the toggle table at a new frame. The channel is stopped
+//	meanwhile, the port is set to the word of the digit the next
+//	transfer starts from, so the toggles stay in step with the pins.
+//	A trigger that lands in this window is dropped, one digit stays
+//	lit for an extra dwell.
+//
+static void Display_load(const uint32_t* words)
+{
+	uint32_t select = 0, next = 0;
+	uint16_t i = 0;
+
+	UDMACC26XX_channelDisable(Display_dma, (1 << DISPLAY_DMA_CH));
+
+	select = (uDMAChannelAttributeGet(UDMA0_BASE, DISPLAY_DMA_CH) & UDMA_ATTR_ALTSELECT) ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+	next   = Display_dmaLength - uDMAChannelSizeGet(UDMA0_BASE, DISPLAY_DMA_CH | select);
+
+	PIN_setPortOutputValue(Display_handle, words[next % Display_numDigits]);
+
+	for (i = 0; i < Display_dmaLength; i++)
+	{
+		Display_toggles[i] = words[i % Display_numDigits] ^ words[(i + 1) % Display_numDigits];
+	}
+
+	UDMACC26XX_channelEnable(Display_dma, (1 << DISPLAY_DMA_CH));
+}
+
+//
+//	Open the multiplex timer and arm the transfers from digit 0, the
+//	channel is enabled by the first Display_load() and the timer by
+//	Display_run().
+//
+static void Display_start(void)
+{
+	GPTimerCC26XX_Params timerParams;
+
+	GPTimerCC26XX_Params_init(&timerParams);
+	timerParams.width          = GPT_CONFIG_32BIT;
+	timerParams.mode           = GPT_MODE_PERIODIC_UP;
+	timerParams.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+	Display_timer = GPTimerCC26XX_open(DISPLAY_TIMER, &timerParams);
+	if (!Display_timer) System_abort("Error opening display timer\n");
+
+	Display_timerBase = ((GPTimerCC26XX_HWAttrs const *)Display_timer->hwAttrs)->baseAddr;
+
+	GPTimerCC26XX_setLoadValue(Display_timer, (Display_dwellUs * DISPLAY_TIMER_TICKS_PER_US) - 1);
+
+	//
+	//	Every timeout is a uDMA request.
+	//
+	HWREG(Display_timerBase + GPT_O_DMAEV) = GPT_DMAEV_TATODMAEN;
+	GPTimerCC26XX_registerInterrupt(Display_timer, Display_dmaCallback, 0);
+
+	Display_dma = UDMACC26XX_open();
+	if (!Display_dma) System_abort("Error opening uDMA\n");
+
+	Display_dmaLength = DISPLAY_DMA_LENGTH - (DISPLAY_DMA_LENGTH % Display_numDigits);
+	Display_arm(UDMA_PRI_SELECT);
+	Display_arm(UDMA_ALT_SELECT);
+
+	TimerIntEnable(Display_timerBase, TIMER_TIMA_DMA);
+}
+
+static void Display_halt(void)
+{
+	UDMACC26XX_channelDisable(Display_dma, (1 << DISPLAY_DMA_CH));
+	GPTimerCC26XX_stop(Display_timer);
+}
+
+//
+//	Reloading the front frame sets the port and enables the channel
+//	again.
+//
+static void Display_run(void)
+{
+	GPTimerCC26XX_start(Display_timer);
+	Display_load(Display_frames[Display_front]);
+}
+
+#endif
+
+#if CPULOAD
+
+//
+//	Refresh statistics line sent after the CPU load report, only the
+//	timer refresh measures its latency.
+//
+static Int Display_report(char* line)
+{
+	Display_Stats stats;
+
+	Display_getStats(&stats);
+
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+	return System_sprintf(line, "display: refreshes %u, latency min %u ns, mean %u ns, max %u ns, jitter %u ns\n",
+	                      stats.refreshes, stats.minLatencyNs, stats.meanLatencyNs, stats.maxLatencyNs, stats.maxJitterNs);
+#else
+	return System_sprintf(line, "display: refreshes %u\n", stats.refreshes);
+#endif
+}
+
+#endif
+
+void Display_Params_init(Display_Params* params)
+{
+	uint8_t i = 0;
+
+	for (i = 0; i < DISPLAY_NUM_SEGMENTS; i++) params->segmentPins[i] = PIN_UNASSIGNED;
+	for (i = 0; i < DISPLAY_MAX_DIGITS; i++)   params->digitPins[i]   = PIN_UNASSIGNED;
+
+	params->numDigits      = 0;
+	params->polarity       = DISPLAY_COMMON_CATHODE;
+	params->digitActiveLow = FALSE;
+	params->scanHz         = 0;
+
+	params->brightness       = DISPLAY_BRIGHTNESS_LEVELS - 1;
+	params->segmentCurrentUa = DISPLAY_SEGMENT_CURRENT_UA;
+}
+
+void Display_init(const Display_Params* params)
+{
+	static const uint32_t blank[DISPLAY_MAX_DIGITS] = { 0 };
+	uint32_t digitMask = 0, scanHz = 0, level = 0;
+	uint8_t  i = 0, n = 0;
+
+	if ((params->numDigits < 1) || (params->numDigits > DISPLAY_MAX_DIGITS))
+	{
+		System_abort("Display supports 1 to 8 digits\n");
+	}
+
+	Display_numDigits        = params->numDigits;
+	Display_digitActiveLow   = params->digitActiveLow;
+	Display_segmentCurrentUa = params->segmentCurrentUa;
+	Display_brightness       = (params->brightness < DISPLAY_BRIGHTNESS_LEVELS) ? params->brightness : (DISPLAY_BRIGHTNESS_LEVELS - 1);
+
+	//
+	//	Pin table, every pin starts at its off level.
+	//
+	level = (params->polarity == DISPLAY_COMMON_ANODE) ? PIN_GPIO_HIGH : PIN_GPIO_LOW;
+	for (i = 0; i < DISPLAY_NUM_SEGMENTS; i++)
+	{
+		Display_segmentMask |= _BV(params->segmentPins[i]);
+		Display_pinTable[n++] = params->segmentPins[i] | PIN_GPIO_OUTPUT_EN | level | PIN_PUSHPULL | PIN_DRVSTR_MIN;
+	}
+
+	level = params->digitActiveLow ? PIN_GPIO_HIGH : PIN_GPIO_LOW;
+	for (i = 0; i < Display_numDigits; i++)
+	{
+		Display_digitPins[i] = params->digitPins[i];
+		digitMask |= _BV(params->digitPins[i]);
+		Display_pinTable[n++] = params->digitPins[i] | PIN_GPIO_OUTPUT_EN | level | PIN_PUSHPULL | PIN_DRVSTR_MAX;
+	}
+	Display_pinTable[n] = PIN_TERMINATE;
+
+	Display_handle = PIN_open(&Display_state, Display_pinTable);
+	if (!Display_handle) System_abort("Error allocating pins - Display_pinTable\n");
+
+	//
+	//	Polarity is folded into the rendered words: segments are
+	//	inverted on a common anode module, and every digit's word
+	//	carries the off level of all the other digits. The PWM lights
+	//	the digits itself, their words have all of them off.
+	//
+	Display_segmentInvert = (params->polarity == DISPLAY_COMMON_ANODE) ? Display_segmentMask : 0;
+	Display_offWord       = Display_segmentInvert | (params->digitActiveLow ? digitMask : 0);
+
+	for (i = 0; i < Display_numDigits; i++)
+	{
+#if DISPLAY_PWM
+		Display_digitWords[i] = params->digitActiveLow ? digitMask : 0;
+#else
+		Display_digitWords[i] = params->digitActiveLow ? (digitMask & ~_BV(params->digitPins[i])) : _BV(params->digitPins[i]);
+#endif
+	}
+
+	//
+	//	Dwell of the scan rate, at least DISPLAY_MIN_SCAN_HZ for a
+	//	flicker free display. The Clock refresh rounds it down to whole
+	//	Clock ticks, the timers to microseconds.
+	//
+	scanHz = (params->scanHz > DISPLAY_MIN_SCAN_HZ) ? params->scanHz : DISPLAY_MIN_SCAN_HZ;
+	Display_dwellUs = 1000000 / (scanHz * Display_numDigits);
+#if DISPLAY_MODE == DISPLAY_MODE_CLOCK
+	Display_dwellUs -= Display_dwellUs % Clock_tickPeriod;
+	if (Display_dwellUs < Clock_tickPeriod) Display_dwellUs = Clock_tickPeriod;
+#endif
+	if (!Display_dwellUs) Display_dwellUs = 1;
+
+#if DISPLAY_PWM
+	Display_pwmOpen();
+#endif
+	Display_start();
+	Display_write(blank);
+	Display_on();
+
+	CpuLoad_addReport(Display_report);
+}
+
+void Display_write(const uint32_t* segments)
+{
+	uint8_t scan = 0, back = 0, i = 0;
+	UInt key = 0;
+
+	//
+	//	Point the front back at the frame being scanned, a scan that
+	//	starts while rendering then can't latch the back frame. The
+	//	timer refresh latches from a Hwi.
+	//
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+	key = Hwi_disable();
+#else
+	key = Swi_disable();
+#endif
+	scan = Display_scan;
+	Display_front = scan;
+	back = !scan;
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+	Hwi_restore(key);
+#else
+	Swi_restore(key);
+#endif
+
+	for (i = 0; i < Display_numDigits; i++)
+	{
+		Display_frames[back][i] = ((segments[i] & Display_segmentMask) ^ Display_segmentInvert) | Display_digitWords[i];
+	}
+
+	Display_front = back;
+
+	//
+	//	The uDMA walks a toggle table instead of the frames.
+	//
+#if DISPLAY_MODE == DISPLAY_MODE_DMA
+	if (Display_lit) Display_load(Display_frames[back]);
+#endif
+}
+
+void Display_off(void)
+{
+	UInt key = 0;
+
+	if (!Display_lit) return;
+
+	//
+	//	A refresh can't run between stopping the backend and blanking
+	//	the port, it would light a digit again.
+	//
+	key = Hwi_disable();
+
+	Display_lit = FALSE;
+	Display_halt();
+
+#if DISPLAY_PWM
+	PINCC26XX_setMux(Display_handle, Display_digitPins[Display_pwmDigit], IOC_PORT_GPIO);
+	GPTimerCC26XX_stop(Display_pwm);
+#endif
+
+	PIN_setPortOutputValue(Display_handle, Display_offWord);
+
+	Hwi_restore(key);
+}
+
+void Display_on(void)
+{
+#if DISPLAY_PWM
+	UInt key = 0;
+#endif
+
+	if (Display_lit) return;
+
+	Display_lit = TRUE;
+
+#if DISPLAY_PWM
+	//
+	//	The refresh starts right after the PWM, an interrupt between
+	//	the two would move the digit changes off the PWM periods.
+	//
+	key = Hwi_disable();
+	GPTimerCC26XX_start(Display_pwm);
+	Display_run();
+	Hwi_restore(key);
+#else
+	Display_run();
+#endif
+}
+
+Bool Display_isOn(void)
+{
+	return Display_lit;
+}
+
+uint32_t Display_getDwell(void)
+{
+	return Display_dwellUs;
+}
+
+void Display_setBrightness(uint8_t level)
+{
+	Display_brightness = (level < DISPLAY_BRIGHTNESS_LEVELS) ? level : (DISPLAY_BRIGHTNESS_LEVELS - 1);
+
+#if DISPLAY_PWM
+	Display_pwmApply();
+#endif
+}
+
+uint8_t Display_getBrightness(void)
+{
+	return Display_brightness;
+}
+
+uint16_t Display_getDuty(uint8_t level)
+{
+#if DISPLAY_PWM
+	return Display_duty[(level < DISPLAY_BRIGHTNESS_LEVELS) ? level : (DISPLAY_BRIGHTNESS_LEVELS - 1)];
+#else
+	return 1000;
+#endif
+}
+
+uint32_t Display_getCurrent(uint8_t level)
+{
+	return (DISPLAY_NUM_SEGMENTS * Display_segmentCurrentUa * Display_getDuty(level)) / 1000;
+}
+
+void Display_getStats(Display_Stats* stats)
+{
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+	UInt key = Hwi_disable();
+
+	stats->refreshes     = Display_refreshes;
+	stats->minLatencyNs  = Display_latencies ? Display_toNs(Display_minLatency) : 0;
+	stats->meanLatencyNs = Display_latencies ? Display_toNs(Display_sumLatency / Display_latencies) : 0;
+	stats->maxLatencyNs  = Display_toNs(Display_maxLatency);
+	stats->maxJitterNs   = Display_toNs(Display_maxJitter);
+
+	Hwi_restore(key);
+#else
+	stats->refreshes     = Display_refreshes;
+	stats->minLatencyNs  = 0;
+	stats->meanLatencyNs = 0;
+	stats->maxLatencyNs  = 0;
+	stats->maxJitterNs   = 0;
+#endif
+}
+
+void Display_resetStats(void)
+{
+#if DISPLAY_MODE == DISPLAY_MODE_TIMER
+	UInt key = Hwi_disable();
+
+	Display_minLatency = ~(uint32_t)0;
+	Display_maxLatency = 0;
+	Display_maxJitter  = 0;
+	Display_sumLatency = 0;
+	Display_latencies  = 0;
+	Display_refreshes  = 0;
+
+	Hwi_restore(key);
+#else
+	Display_refreshes = 0;
+#endif
+}
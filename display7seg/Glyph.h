@@ -0,0 +1,38 @@
+#ifndef __GLYPH_H__
+#define __GLYPH_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+//
+//	Glyph indexes. 0 to 15 are the hex digits, so a digit value
+//	indexes the table directly.
+//
+#define GLYPH_HEX_A							10
+#define GLYPH_HEX_B							11
+#define GLYPH_HEX_C							12
+#define GLYPH_HEX_D							13
+#define GLYPH_HEX_E							14
+#define GLYPH_HEX_F							15
+#define GLYPH_MINUS							16
+#define GLYPH_DEGREE						17
+#define GLYPH_BLANK							18
+#define GLYPH_LETTER_E					GLYPH_HEX_E
+#define GLYPH_LETTER_R					19
+#define GLYPH_LETTER_H					20
+#define GLYPH_LETTER_I					21
+#define GLYPH_LETTER_L					22
+#define GLYPH_LETTER_O					23
+
+#define GLYPH_COUNT							24
+
+//
+//	Segment masks of every glyph, built from the SEGMENT_x pin map
+//	at compile time and stored in flash. Display_write() takes them
+//	as they are.
+//
+extern const uint32_t Glyph_table[GLYPH_COUNT];
+
+#endif
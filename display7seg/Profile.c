@@ -0,0 +1,234 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Task.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/UART.h>
+
+#include "Profile.h"
+#include "Cycles.h"
+#include "CpuLoad.h"
+
+#if PROFILE
+
+//
+//	Microseconds of a cycle count in hundredths, printed as %u.%02u.
+//
+#define Profile_toCentiMicros(cycles)	((uint32_t)(((uint64_t)(cycles) * 100) / CYCLES_PER_US))
+
+#define PROFILE_STACK_SIZE			512
+#define PROFILE_LINE_SIZE				512
+#define PROFILE_CALIBRATE_RUNS	8
+
+static Task_Struct Profile_taskStruct;
+static Char        Profile_taskStack[PROFILE_STACK_SIZE];
+
+static UART_Handle Profile_uart;
+
+CPULOAD_HANDLER(Profile_dumpLoad, "profile", CPULOAD_TASK);
+
+//
+//	Regions seen so far, linked in on their first run.
+//
+static Profile_Region* Profile_regions;
+static uint8_t         Profile_numRegions;
+
+//
+//	Cycles an empty region measures, taken off every run.
+//
+static uint32_t Profile_overhead;
+
+void Profile_begin(Profile_Region* region)
+{
+	region->start = Cycles_now();
+}
+
+void Profile_end(Profile_Region* region)
+{
+	uint32_t cycles = Cycles_now() - region->start;
+	uint32_t bound  = 1 << PROFILE_MIN_SHIFT;
+	UInt key = 0;
+	uint8_t i = 0;
+
+	cycles = (cycles > Profile_overhead) ? (cycles - Profile_overhead) : 0;
+
+	while ((i < PROFILE_NUM_BUCKETS - 1) && (cycles > bound))
+	{
+		bound <<= 1;
+		i++;
+	}
+
+	key = Hwi_disable();
+
+	if (!region->linked)
+	{
+		region->linked = TRUE;
+		region->next   = Profile_regions;
+		Profile_regions = region;
+		Profile_numRegions++;
+	}
+
+	if (!region->count || (cycles < region->min)) region->min = cycles;
+	if (cycles > region->max) region->max = cycles;
+	region->count++;
+	region->sum += cycles;
+	region->buckets[i]++;
+
+	Hwi_restore(key);
+}
+
+void Profile_reset(void)
+{
+	Profile_Region* region = NULL;
+	UInt key = Hwi_disable();
+	uint8_t i = 0;
+
+	for (region = Profile_regions; region; region = region->next)
+	{
+		region->count = 0;
+		region->min   = 0;
+		region->max   = 0;
+		region->sum   = 0;
+		for (i = 0; i < PROFILE_NUM_BUCKETS; i++) region->buckets[i] = 0;
+	}
+
+	Hwi_restore(key);
+}
+
+//
+//	Format the line of one region, from a copy taken with Hwis
+//	disabled so that it is consistent.
+//
+static Int Profile_format(const Profile_Region* region, char* line)
+{
+	Profile_Region copy;
+	uint32_t mean = 0, min = 0, max = 0, bound = 1 << PROFILE_MIN_SHIFT;
+	UInt key = 0;
+	Int  length = 0;
+	uint8_t i = 0;
+
+	key = Hwi_disable();
+	copy = *region;
+	Hwi_restore(key);
+
+	if (copy.count) mean = (uint32_t)(copy.sum / copy.count);
+
+	min  = Profile_toCentiMicros(copy.min);
+	max  = Profile_toCentiMicros(copy.max);
+
+	length = System_sprintf(line, "%s: runs %u, min %u, mean %u, max %u cycles, min %u.%02u, mean %u.%02u, max %u.%02u us,",
+	                        copy.name, copy.count, copy.min, mean, copy.max,
+	                        min / 100, min % 100,
+	                        Profile_toCentiMicros(mean) / 100, Profile_toCentiMicros(mean) % 100,
+	                        max / 100, max % 100);
+
+	for (i = 0; i < PROFILE_NUM_BUCKETS; i++, bound <<= 1)
+	{
+		if (!copy.buckets[i]) continue;
+
+		if (i == PROFILE_NUM_BUCKETS - 1)
+		{
+			length += System_sprintf(line + length, " >%u:%u", bound >> 1, copy.buckets[i]);
+		}
+		else
+		{
+			length += System_sprintf(line + length, " <=%u:%u", bound, copy.buckets[i]);
+		}
+	}
+
+	line[length++] = '\n';
+
+	return length;
+}
+
+void Profile_dump(void)
+{
+	static char line[PROFILE_LINE_SIZE];
+	Profile_Region* region = NULL;
+	Int length = 0;
+
+	length = System_sprintf(line, "profile: regions %u, %u cycles/us, overhead %u cycles\n",
+	                        Profile_numRegions, CYCLES_PER_US, Profile_overhead);
+	CpuLoad_write(Profile_uart, line, length);
+
+	//
+	//	Regions only ever get linked in at the head, the list past
+	//	the head read here stays as it is. Only the formatting counts
+	//	toward the load, the task blocks while a line goes out.
+	//
+	for (region = Profile_regions; region; region = region->next)
+	{
+		CpuLoad_begin(&Profile_dumpLoad);
+		length = Profile_format(region, line);
+		CpuLoad_end(&Profile_dumpLoad);
+
+		CpuLoad_write(Profile_uart, line, length);
+	}
+}
+
+//
+//	Any byte received dumps the table, an 'r' clears it after.
+//
+static void Profile_task(UArg arg0, UArg arg1)
+{
+	char request = 0;
+
+	while (1)
+	{
+		if (UART_read(Profile_uart, &request, 1) != 1) continue;
+
+		Profile_dump();
+
+		if (request == 'r')
+		{
+			CpuLoad_begin(&Profile_dumpLoad);
+			Profile_reset();
+			CpuLoad_end(&Profile_dumpLoad);
+		}
+	}
+}
+
+void Profile_init(UART_Handle uart)
+{
+	Profile_Region calibration = { "calibration" };
+	Task_Params taskParams;
+	uint8_t i = 0;
+
+	Profile_uart = uart;
+
+	Cycles_init();
+
+	//
+	//	The cost of the brackets themselves, the least an empty region
+	//	measures. Calibration is the only region linked so far.
+	//
+	for (i = 0; i < PROFILE_CALIBRATE_RUNS; i++)
+	{
+		Profile_begin(&calibration);
+		Profile_end(&calibration);
+	}
+
+	Profile_overhead   = calibration.min;
+	Profile_regions    = NULL;
+	Profile_numRegions = 0;
+
+	Task_Params_init(&taskParams);
+	taskParams.stackSize = PROFILE_STACK_SIZE;
+	taskParams.stack     = Profile_taskStack;
+	Task_construct(&Profile_taskStruct, (Task_FuncPtr)Profile_task, &taskParams, NULL);
+}
+
+#endif
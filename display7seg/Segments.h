@@ -0,0 +1,22 @@
+#ifndef __SEGMENTS_H__
+#define __SEGMENTS_H__
+
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+//
+//	Segment pin map of the seven segment display. The glyph table
+//	is generated from it, changing a pin here moves that segment in
+//	every glyph.
+//
+#define SEGMENT_A								PIN_ID(28)
+#define SEGMENT_B								PIN_ID(30)
+#define SEGMENT_C								PIN_ID(24)
+#define SEGMENT_D								PIN_ID(22)
+#define SEGMENT_E								PIN_ID(23)
+#define SEGMENT_F								PIN_ID(29)
+#define SEGMENT_G								PIN_ID(21)
+
+#endif
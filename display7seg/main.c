@@ -20,49 +20,41 @@
 //
 #include <ti/drivers/PIN.h>
 #include <ti/drivers/Power.h>
-//
-//	Bitwise operations.
-//
-#define _BV(bit)				(1 << (bit))
+#include <ti/drivers/UART.h>
+
+#include <Board.h>
+
+#include "Display.h"
+#include "Segments.h"
+#include "Glyph.h"
+#include "CpuLoad.h"
+#include "Profile.h"
 
 //
-//	Defines for the seven segment display.
+//	Defines for the seven segment display, the segment pins are in
+//	Segments.h.
 //
-#define SEGMENT_A		PIN_ID(28)
-#define SEGMENT_B		PIN_ID(30)
-#define SEGMENT_C		PIN_ID(24)
-#define SEGMENT_D		PIN_ID(22)
-#define SEGMENT_E		PIN_ID(23)
-#define SEGMENT_F		PIN_ID(29)
-#define SEGMENT_G		PIN_ID(21)
-
 #define DISPLAY_UNITS	PIN_ID(27)
 #define DISPLAY_TENS	PIN_ID(26)
 
+#define NUM_DIGITS		2
+
 //
 //	Default task stack size.
 //
 #define STACK_SIZE		512
 
 //
-//	Task structure and stack.
-//
-Task_Struct segmentDisplay_TaskStruct;
-Char segmentDisplay_TaskStack[STACK_SIZE];
-
-//
-//	Clock structure.
+//	Clock ticks of a time in milliseconds, whatever the .cfg sets
+//	Clock.tickPeriod to.
 //
-Clock_Struct segmentDisplay_ClkStruct;
+#define MS_TO_TICKS(ms)	(((ms) * 1000) / Clock_tickPeriod)
 
 //
-//	PIN driver handle.
+//	Task structure and stack.
 //
-PIN_Handle segmentPin_Handle;
-PIN_State  segmentPin_State;
-
-PIN_Handle displayPin_Handle;
-PIN_State  displayPin_State;
+Task_Struct segmentDisplay_TaskStruct;
+Char segmentDisplay_TaskStack[STACK_SIZE];
 
 //
 //	PIN default pin configuration table.
@@ -81,87 +73,30 @@ PIN_Config gpioInit_Table[] =
 	PIN_TERMINATE
 };
 
-//
-//	PIN seven segment led pin configuration table.
-//
-PIN_Config segmentPin_Table[] =
-{
-	SEGMENT_A | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_B | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_C | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_D | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_E | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_F | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	SEGMENT_G | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MIN,
-	PIN_TERMINATE
-};
-
-//
-//	PIN display digits pin configuration table.
-//
-PIN_Config displayPin_Table[] =
-{
-	DISPLAY_UNITS | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	DISPLAY_TENS  | PIN_GPIO_OUTPUT_EN | PIN_GPIO_LOW | PIN_PUSHPULL | PIN_DRVSTR_MAX,
-	PIN_TERMINATE
-};
-
-//
-//	Array of seven segment display numbers.
-//
-uint32_t displayNumber[] =
-{
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F)),
-	(_BV(SEGMENT_B) | _BV(SEGMENT_C)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_E) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-	(_BV(SEGMENT_A) | _BV(SEGMENT_B) | _BV(SEGMENT_C) | _BV(SEGMENT_D) | _BV(SEGMENT_F) | _BV(SEGMENT_G)),
-};
-
-bool flag = true;
-uint8_t currentUnit = 0, currentTen = 0;
-
-void segmentDisplay_Clock(UArg arg0)
-{
-	//
-	//	Switch the display pin on from units to tens and vice versa.
-	//
-	if (flag)
-	{
-		PIN_setOutputValue(displayPin_Handle, DISPLAY_TENS,  0);
-		PIN_setOutputValue(displayPin_Handle, DISPLAY_UNITS, 1);
-		PIN_setPortOutputValue(segmentPin_Handle, displayNumber[currentUnit]);
-	}
-	else
-	{
-		PIN_setOutputValue(displayPin_Handle, DISPLAY_UNITS, 0);
-		PIN_setOutputValue(displayPin_Handle, DISPLAY_TENS,  1);
-		PIN_setPortOutputValue(segmentPin_Handle, displayNumber[currentTen]);
-	}
-
-	flag = !flag;
-}
+CPULOAD_HANDLER(segmentDisplay_Load, "main", CPULOAD_TASK);
 
 void segmentDisplay_Task(UArg arg0, UArg arg1)
 {
+	uint32_t segments[NUM_DIGITS];
 	uint8_t i = 0, j = 0;
 	while (1)
 	{
 		//
-		//	Count up to 99 and restart.
+		//	Count up to 99 and restart, one brightness step down every
+		//	ten counts starting from full.
 		//
 		for (i = 0; i < 10; i++)
 		{
-			currentTen = i;
+			Display_setBrightness((DISPLAY_BRIGHTNESS_LEVELS - 1) - (i % DISPLAY_BRIGHTNESS_LEVELS));
+
+			segments[0] = Glyph_table[i];
 			for (j = 0; j < 10; j++)
 			{
-				currentUnit = j;
-				Task_sleep(500000 / Clock_tickPeriod);
+				CpuLoad_begin(&segmentDisplay_Load);
+				segments[1] = Glyph_table[j];
+				Display_write(segments);
+				CpuLoad_end(&segmentDisplay_Load);
+				Task_sleep(MS_TO_TICKS(500));
 			}
 		}
 	}
@@ -170,7 +105,10 @@ void segmentDisplay_Task(UArg arg0, UArg arg1)
 int main(void)
 {
 	Task_Params segmentDisplay_TaskParams;
-	Clock_Params segmentDisplay_ClkParams;
+	Display_Params displayParams;
+	UART_Params uartParams;
+	UART_Handle uart;
+	uint8_t level = 0;
 
 	//
 	//	Power manager initialization.
@@ -186,20 +124,48 @@ int main(void)
 	}
 
 	//
-	//	Allocate collection of pins.
+	//	Seven segment display, tens then units.
+	//
+	Display_Params_init(&displayParams);
+	displayParams.segmentPins[0] = SEGMENT_A;
+	displayParams.segmentPins[1] = SEGMENT_B;
+	displayParams.segmentPins[2] = SEGMENT_C;
+	displayParams.segmentPins[3] = SEGMENT_D;
+	displayParams.segmentPins[4] = SEGMENT_E;
+	displayParams.segmentPins[5] = SEGMENT_F;
+	displayParams.segmentPins[6] = SEGMENT_G;
+	displayParams.digitPins[0]   = DISPLAY_TENS;
+	displayParams.digitPins[1]   = DISPLAY_UNITS;
+	displayParams.numDigits      = NUM_DIGITS;
+	Display_init(&displayParams);
+
+	//
+	//	Current draw of every brightness step, all segments lit.
 	//
-	segmentPin_Handle = PIN_open(&segmentPin_State, segmentPin_Table);
-	if (!segmentPin_Handle)
+	for (level = 0; level < DISPLAY_BRIGHTNESS_LEVELS; level++)
 	{
-		System_abort("Error allocating segmentPin_Table\n");
+		System_printf("brightness %d: duty %d/1000, %d uA\n", level, Display_getDuty(level), Display_getCurrent(level));
+		System_flush();
 	}
 
-	displayPin_Handle = PIN_open(&displayPin_State, displayPin_Table);
-	if (!displayPin_Handle)
+	//
+	//	CPU load reports and profile dumps over the UART.
+	//
+	Board_initUART();
+	UART_Params_init(&uartParams);
+	uartParams.writeDataMode = UART_DATA_TEXT;
+	uartParams.readDataMode  = UART_DATA_TEXT;
+	uartParams.readEcho      = UART_ECHO_OFF;
+	uartParams.baudRate      = 115200;
+	uart = UART_open(Board_UART0, &uartParams);
+	if (!uart)
 	{
-		System_abort("Error allocating displayPin_Table\n");
+		System_abort("Error opening the UART\n");
 	}
 
+	CpuLoad_init(uart);
+	Profile_init(uart);
+
 	//
 	//	Construct a Task thread.
 	//
@@ -208,14 +174,6 @@ int main(void)
 	segmentDisplay_TaskParams.stack = segmentDisplay_TaskStack;
 	Task_construct(&segmentDisplay_TaskStruct, (Task_FuncPtr)segmentDisplay_Task, &segmentDisplay_TaskParams, NULL);
 
-	//
-	//	Construct a periodic Clock Instance.
-	//
-	Clock_Params_init(&segmentDisplay_ClkParams);
-	segmentDisplay_ClkParams.period = 1000;
-	segmentDisplay_ClkParams.startFlag = TRUE;
-	Clock_construct(&segmentDisplay_ClkStruct, (Clock_FuncPtr)segmentDisplay_Clock, 1000, &segmentDisplay_ClkParams);
-
   BIOS_start();
 
   return (0);
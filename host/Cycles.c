@@ -0,0 +1,29 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include "Cycles.h"
+#include "Sim.h"
+#include "SimPower.h"
+
+//
+//	Host build of Cycles, simulated time runs at the CPU clock. The
+//	DWT counter stops while the CPU sleeps, so does this one.
+//
+void Cycles_init(void)
+{
+}
+
+uint32_t Cycles_now(void)
+{
+	const SimPower_Stats* stats = NULL;
+
+	//
+	//	A register read, it takes time like the pins.
+	//
+	Sim_spend(SIM_COST_IO);
+	stats = SimPower_getStats();
+
+	return (uint32_t)stats->active;
+}
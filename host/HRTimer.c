@@ -0,0 +1,55 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include "HRTimer.h"
+#include "Sim.h"
+
+//
+//	Host build of HRTimer, the timer counts simulated time directly.
+//
+void HRTimer_init(void)
+{
+}
+
+//
+//	The GPTimer driver keeps the device out of standby while the
+//	timer runs.
+//
+static Bool HRTimer_running = FALSE;
+
+void HRTimer_start(void)
+{
+	if (HRTimer_running) return;
+
+	HRTimer_running = TRUE;
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+}
+
+void HRTimer_stop(void)
+{
+	if (!HRTimer_running) return;
+
+	HRTimer_running = FALSE;
+	Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+}
+
+uint32_t HRTimer_now(void)
+{
+	//
+	//	Reading the timer takes time like any register read.
+	//
+	Sim_spend(SIM_COST_IO);
+
+	return (uint32_t)Sim_now();
+}
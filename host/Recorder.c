@@ -0,0 +1,211 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <string.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+#include "Sim.h"
+#include "SimPin.h"
+#include "Recorder.h"
+
+//
+//	Segment patterns of the decimal digits and of the minus sign,
+//	bit 0 is segment A.
+//
+static const uint8_t Recorder_decimal[10] =
+{
+	0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+#define RECORDER_MINUS					0x40
+
+static Recorder_Params Recorder_params;
+static Recorder_Stats  Recorder_stats;
+static uint32_t        Recorder_mask;
+
+static Recorder_Write Recorder_log[RECORDER_LOG_SIZE];
+static uint32_t       Recorder_logCount;
+
+//
+//	Per digit: lit now, pattern shown while lit, pattern it settled
+//	on the last time it was turned off, and when it was last lit.
+//
+static Bool     Recorder_lit[RECORDER_MAX_DIGITS];
+static uint8_t  Recorder_current[RECORDER_MAX_DIGITS];
+static uint8_t  Recorder_settled[RECORDER_MAX_DIGITS];
+static Sim_Time Recorder_litTime[RECORDER_MAX_DIGITS];
+static Bool     Recorder_seen[RECORDER_MAX_DIGITS];
+
+//
+//	Time the on time and segment time were last brought up to.
+//
+static Sim_Time Recorder_since;
+
+static Bool Recorder_level(uint32_t outputs, PIN_Id pinId, Bool activeLow)
+{
+	return ((outputs >> pinId) & 1) != activeLow;
+}
+
+//
+//	Account the time since the last change to the digits lit then.
+//
+static void Recorder_integrate(Sim_Time now)
+{
+	Sim_Time elapsed = now - Recorder_since;
+	uint8_t  i = 0;
+
+	for (i = 0; i < Recorder_params.numDigits; i++)
+	{
+		if (!Recorder_lit[i]) continue;
+
+		Recorder_stats.onTime[i]   += elapsed;
+		Recorder_stats.segmentTime += elapsed * __builtin_popcount(Recorder_current[i]);
+	}
+
+	Recorder_since = now;
+}
+
+static void Recorder_writeFxn(uint32_t written, uint32_t outputs)
+{
+	Recorder_Write* entry = NULL;
+	uint8_t  segments = 0, numLit = 0, i = 0;
+	Bool     lit = FALSE;
+	Sim_Time now = Sim_now();
+
+	if (!(written & Recorder_mask)) return;
+
+	Recorder_integrate(now);
+
+	entry = &Recorder_log[Recorder_logCount++ % RECORDER_LOG_SIZE];
+	entry->time    = now;
+	entry->written = written;
+	entry->outputs = outputs;
+	Recorder_stats.writes++;
+
+	for (i = 0; i < RECORDER_NUM_SEGMENTS; i++)
+	{
+		segments |= Recorder_level(outputs, Recorder_params.segmentPins[i], Recorder_params.segmentActiveLow) << i;
+	}
+
+	for (i = 0; i < Recorder_params.numDigits; i++)
+	{
+		lit = Recorder_level(outputs, Recorder_params.digitPins[i], Recorder_params.digitActiveLow);
+
+		if (lit && !Recorder_lit[i])
+		{
+			//
+			//	Turned on, one more refresh of this digit.
+			//
+			if (Recorder_seen[i] && ((now - Recorder_litTime[i]) > Recorder_stats.maxGap[i]))
+			{
+				Recorder_stats.maxGap[i] = now - Recorder_litTime[i];
+			}
+
+			Recorder_stats.refreshes[i]++;
+			Recorder_litTime[i] = now;
+			Recorder_seen[i] = TRUE;
+			Recorder_current[i] = segments;
+		}
+		else if (lit && (Recorder_current[i] != segments))
+		{
+			Recorder_stats.glitches++;
+			Recorder_current[i] = segments;
+		}
+		else if (!lit && Recorder_lit[i])
+		{
+			Recorder_settled[i] = Recorder_current[i];
+		}
+
+		Recorder_lit[i] = lit;
+		numLit += lit;
+	}
+
+	if (numLit > 1) Recorder_stats.glitches++;
+}
+
+void Recorder_Params_init(Recorder_Params* params)
+{
+	memset(params, 0, sizeof(Recorder_Params));
+	memset(params->segmentPins, PIN_UNASSIGNED, sizeof(params->segmentPins));
+	memset(params->digitPins, PIN_UNASSIGNED, sizeof(params->digitPins));
+}
+
+void Recorder_init(const Recorder_Params* params)
+{
+	uint8_t i = 0;
+
+	Recorder_params = *params;
+	Recorder_mask = 0;
+
+	for (i = 0; i < RECORDER_NUM_SEGMENTS; i++) Recorder_mask |= (uint32_t)1 << params->segmentPins[i];
+	for (i = 0; i < params->numDigits; i++) Recorder_mask |= (uint32_t)1 << params->digitPins[i];
+
+	SimPin_watchWrites(Recorder_writeFxn);
+}
+
+uint8_t Recorder_getSegments(uint8_t digit)
+{
+	return Recorder_lit[digit] ? Recorder_current[digit] : Recorder_settled[digit];
+}
+
+int Recorder_getDigit(uint8_t digit)
+{
+	uint8_t segments = Recorder_getSegments(digit);
+	int value = 0;
+
+	for (value = 0; value < 10; value++)
+	{
+		if (Recorder_decimal[value] == segments) return value;
+	}
+
+	return -1;
+}
+
+int32_t Recorder_getValue(void)
+{
+	int32_t value = 0;
+	int     digit = 0;
+	Bool    minus = FALSE;
+	uint8_t i = 0;
+
+	if ((Recorder_params.numDigits > 1) && (Recorder_getSegments(0) == RECORDER_MINUS))
+	{
+		minus = TRUE;
+		i++;
+	}
+
+	for (; i < Recorder_params.numDigits; i++)
+	{
+		digit = Recorder_getDigit(i);
+		if (digit < 0) return RECORDER_NO_VALUE;
+
+		value = (value * 10) + digit;
+	}
+
+	return minus ? -value : value;
+}
+
+const Recorder_Stats* Recorder_getStats(void)
+{
+	Recorder_integrate(Sim_now());
+
+	return &Recorder_stats;
+}
+
+void Recorder_resetStats(void)
+{
+	memset(&Recorder_stats, 0, sizeof(Recorder_stats));
+	memset(Recorder_seen, 0, sizeof(Recorder_seen));
+	Recorder_since = Sim_now();
+}
+
+const Recorder_Write* Recorder_getWrite(uint32_t age)
+{
+	if ((age >= Recorder_logCount) || (age >= RECORDER_LOG_SIZE)) return NULL;
+
+	return &Recorder_log[(Recorder_logCount - 1 - age) % RECORDER_LOG_SIZE];
+}
@@ -0,0 +1,102 @@
+#ifndef __RECORDER_H__
+#define __RECORDER_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "Sim.h"
+
+//
+//	Seven segment display recorder. It logs every write to the
+//	segment and digit pins, and rebuilds what the multiplexed
+//	display shows from them.
+//
+#define RECORDER_NUM_SEGMENTS		7
+#define RECORDER_MAX_DIGITS			8
+#define RECORDER_LOG_SIZE				256
+
+typedef struct Recorder_Params
+{
+	//
+	//	Segment pins A to G, digit enables most significant first.
+	//
+	PIN_Id  segmentPins[RECORDER_NUM_SEGMENTS];
+	PIN_Id  digitPins[RECORDER_MAX_DIGITS];
+	uint8_t numDigits;
+	Bool    segmentActiveLow;
+	Bool    digitActiveLow;
+} Recorder_Params;
+
+typedef struct Recorder_Write
+{
+	Sim_Time time;
+	uint32_t written;
+	uint32_t outputs;
+} Recorder_Write;
+
+typedef struct Recorder_Stats
+{
+	uint32_t writes;
+
+	//
+	//	Times every digit was lit, and the longest time between two
+	//	of them (the worst multiplex period).
+	//
+	uint32_t refreshes[RECORDER_MAX_DIGITS];
+	Sim_Time maxGap[RECORDER_MAX_DIGITS];
+
+	//
+	//	Torn frames: a digit that showed more than one segment
+	//	pattern while lit, or several digits lit at once.
+	//
+	uint32_t glitches;
+
+	//
+	//	Time every digit was lit, and lit segments integrated over
+	//	time. Over the elapsed time they give the duty of a digit and
+	//	the average number of segments drawing current.
+	//
+	Sim_Time onTime[RECORDER_MAX_DIGITS];
+	Sim_Time segmentTime;
+} Recorder_Stats;
+
+void Recorder_Params_init(Recorder_Params* params);
+void Recorder_init(const Recorder_Params* params);
+
+//
+//	Segment pattern a digit settled on, bit 0 is segment A.
+//
+uint8_t Recorder_getSegments(uint8_t digit);
+
+//
+//	Decimal value of a digit, -1 when it doesn't show one.
+//
+int Recorder_getDigit(uint8_t digit);
+
+//
+//	Decimal value of the whole display, a leading minus makes it
+//	negative. RECORDER_NO_VALUE when a digit doesn't show one.
+//
+#define RECORDER_NO_VALUE				INT32_MIN
+
+int32_t Recorder_getValue(void);
+
+const Recorder_Stats* Recorder_getStats(void);
+void Recorder_resetStats(void);
+
+//
+//	Logged writes, 0 is the most recent. NULL past the log.
+//
+const Recorder_Write* Recorder_getWrite(uint32_t age);
+
+#endif
@@ -0,0 +1,805 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <ucontext.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Swi.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Semaphore.h>
+
+#include "Sim.h"
+#include "SimPower.h"
+
+//
+//	Clock tick period in microseconds, as set in the .cfg.
+//
+#ifndef SIM_TICK_PERIOD
+#define SIM_TICK_PERIOD					1000
+#endif
+
+//
+//	Host stack per task, the firmware stacks are far too small for
+//	host code (printf alone needs more than 512 bytes).
+//
+#define SIM_TASK_STACK_SIZE			(256 * 1024)
+
+//
+//	Task modes.
+//
+#define SIM_TASK_READY					0
+#define SIM_TASK_BLOCKED				1
+#define SIM_TASK_TERMINATED			2
+
+typedef struct Sim_TaskContext
+{
+	ucontext_t       uc;
+	Sim_Event        wake;
+	Semaphore_Handle sem;
+} Sim_TaskContext;
+
+const UInt32 Clock_tickPeriod = SIM_TICK_PERIOD;
+
+//
+//	Task priorities, as set in the .cfg.
+//
+#ifndef SIM_TASK_NUM_PRIORITIES
+#define SIM_TASK_NUM_PRIORITIES	4
+#endif
+
+const Int Task_numPriorities = SIM_TASK_NUM_PRIORITIES;
+
+#define SIM_CLOCK_TICK					Sim_fromMicros(SIM_TICK_PERIOD)
+
+//
+//	Simulation state.
+//
+static Sim_Time      Sim_time;
+static Sim_Time      Sim_limit = ~(Sim_Time)0;
+static uint8_t       Sim_currentLevel = SIM_LEVEL_TASK;
+static Bool          Sim_hwiMasked;
+static Bool          Sim_swiMasked;
+static Sim_Time      Sim_swiMaskStart;
+static Sim_Time      Sim_longestSwiMask;
+static Bool          Sim_stopped;
+static Bool          Sim_error;
+static Sim_Event*    Sim_queue;
+static Sim_OutputFxn Sim_output;
+static Sim_IdleFxn   Sim_idleFxns[SIM_MAX_IDLE_FXNS];
+static uint8_t       Sim_numIdleFxns;
+
+//
+//	Tasks, and the idle context BIOS_start() runs the scheduler on.
+//
+static ucontext_t   Sim_idleContext;
+static Task_Struct* Sim_tasks;
+static Task_Struct* Sim_currentTask;
+
+//
+//	Active clocks sorted by expiry, served by a single Clock Swi.
+//
+static void Sim_clockSwi(UArg arg);
+
+static Clock_Struct* Sim_clocks;
+static Sim_Event     Sim_clockEvent = { 0, Sim_clockSwi, 0, SIM_LEVEL_SWI, 0, NULL };
+
+/******************************************************************************
+ *	Events and time.
+ ******************************************************************************/
+
+void Sim_Event_init(Sim_Event* event, Sim_EventFxn fxn, UArg arg, uint8_t level)
+{
+	event->when   = 0;
+	event->fxn    = fxn;
+	event->arg    = arg;
+	event->level  = level;
+	event->queued = FALSE;
+	event->next   = NULL;
+}
+
+void Sim_cancel(Sim_Event* event)
+{
+	Sim_Event** link = &Sim_queue;
+
+	if (!event->queued) return;
+
+	while (*link != event) link = &(*link)->next;
+	*link = event->next;
+	event->queued = FALSE;
+}
+
+void Sim_schedule(Sim_Event* event, Sim_Time when)
+{
+	Sim_Event** link = &Sim_queue;
+
+	Sim_cancel(event);
+
+	//
+	//	Keep the queue sorted, events due at the same time run in
+	//	the order they were scheduled.
+	//
+	while (*link && ((*link)->when <= when)) link = &(*link)->next;
+
+	event->when   = when;
+	event->next   = *link;
+	event->queued = TRUE;
+	*link = event;
+}
+
+Sim_Time Sim_now(void)
+{
+	return Sim_time;
+}
+
+uint8_t Sim_level(void)
+{
+	return Sim_currentLevel;
+}
+
+static Bool Sim_runnable(const Sim_Event* event)
+{
+	if (event->level == SIM_LEVEL_EXT) return TRUE;
+	if (event->level <= Sim_currentLevel) return FALSE;
+	if (Sim_hwiMasked) return FALSE;
+	if ((event->level == SIM_LEVEL_SWI) && Sim_swiMasked) return FALSE;
+
+	return TRUE;
+}
+
+static Sim_Event* Sim_nextRunnable(Sim_Time until)
+{
+	Sim_Event* event = NULL;
+
+	for (event = Sim_queue; event && (event->when <= until); event = event->next)
+	{
+		if (Sim_runnable(event)) return event;
+	}
+
+	return NULL;
+}
+
+static void Sim_run(Sim_Event* event)
+{
+	uint8_t level = Sim_currentLevel;
+
+	Sim_cancel(event);
+	if (event->when > Sim_time) Sim_time = event->when;
+
+	//
+	//	External events don't preempt anything, they only change the
+	//	state of the simulated world.
+	//
+	if (event->level != SIM_LEVEL_EXT) Sim_currentLevel = event->level;
+	event->fxn(event->arg);
+	Sim_currentLevel = level;
+}
+
+void Sim_spend(Sim_Time ticks)
+{
+	Sim_Time target = Sim_time + ticks;
+	Sim_Time start  = 0;
+	Sim_Event* event = NULL;
+
+	//
+	//	Every handler that preempts the running code delays it by
+	//	the time the handler took.
+	//
+	while ((event = Sim_nextRunnable(target)) != NULL)
+	{
+		start = (event->when > Sim_time) ? event->when : Sim_time;
+		Sim_run(event);
+		target += Sim_time - start;
+	}
+
+	if (target > Sim_time) Sim_time = target;
+}
+
+void Sim_stop(void)
+{
+	Sim_stopped = TRUE;
+}
+
+void Sim_fail(const char* reason)
+{
+	fprintf(stderr, "Sim: %s at %llu us\n", reason, (unsigned long long)Sim_toMicros(Sim_time));
+	Sim_error = TRUE;
+	Sim_stopped = TRUE;
+}
+
+Bool Sim_failed(void)
+{
+	return Sim_error;
+}
+
+void Sim_setLimit(Sim_Time limit)
+{
+	Sim_limit = limit;
+}
+
+void Sim_setOutput(Sim_OutputFxn fxn)
+{
+	Sim_output = fxn;
+}
+
+void Sim_addIdleFunc(Sim_IdleFxn fxn)
+{
+	if (Sim_numIdleFxns == SIM_MAX_IDLE_FXNS)
+	{
+		Sim_fail("too many idle functions");
+		return;
+	}
+
+	Sim_idleFxns[Sim_numIdleFxns++] = fxn;
+}
+
+/******************************************************************************
+ *	Hwi and Swi masking.
+ ******************************************************************************/
+
+UInt Hwi_disable(void)
+{
+	UInt key = Sim_hwiMasked;
+
+	Sim_hwiMasked = TRUE;
+
+	return key;
+}
+
+void Hwi_restore(UInt key)
+{
+	Sim_hwiMasked = key;
+
+	//
+	//	Run whatever became pending while masked.
+	//
+	if (!key) Sim_spend(0);
+}
+
+UInt Swi_disable(void)
+{
+	UInt key = Sim_swiMasked;
+
+	if (!key) Sim_swiMaskStart = Sim_time;
+	Sim_swiMasked = TRUE;
+
+	return key;
+}
+
+void Swi_restore(UInt key)
+{
+	if (!key && Sim_swiMasked && ((Sim_time - Sim_swiMaskStart) > Sim_longestSwiMask))
+	{
+		Sim_longestSwiMask = Sim_time - Sim_swiMaskStart;
+	}
+
+	Sim_swiMasked = key;
+
+	if (!key) Sim_spend(0);
+}
+
+Sim_Time Sim_getLongestSwiMask(void)
+{
+	return Sim_longestSwiMask;
+}
+
+/******************************************************************************
+ *	Clock.
+ ******************************************************************************/
+
+static void Sim_clockUpdate(void)
+{
+	if (Sim_clocks)
+	{
+		Sim_schedule(&Sim_clockEvent, Sim_clocks->when);
+	}
+	else
+	{
+		Sim_cancel(&Sim_clockEvent);
+	}
+}
+
+static void Sim_clockInsert(Clock_Struct* clock)
+{
+	Clock_Struct** link = &Sim_clocks;
+
+	while (*link && ((*link)->when <= clock->when)) link = &(*link)->next;
+
+	clock->next = *link;
+	*link = clock;
+	clock->active = TRUE;
+}
+
+static void Sim_clockRemove(Clock_Struct* clock)
+{
+	Clock_Struct** link = &Sim_clocks;
+
+	if (!clock->active) return;
+
+	while (*link != clock) link = &(*link)->next;
+	*link = clock->next;
+	clock->active = FALSE;
+}
+
+//
+//	The Clock Swi, runs every clock that expired in turn.
+//
+static void Sim_clockSwi(UArg arg)
+{
+	Clock_Struct* clock = NULL;
+
+	while (Sim_clocks && (Sim_clocks->when <= Sim_time))
+	{
+		clock = Sim_clocks;
+		Sim_clockRemove(clock);
+
+		if (clock->period)
+		{
+			clock->when += clock->period * SIM_CLOCK_TICK;
+			Sim_clockInsert(clock);
+		}
+
+		clock->fxn(clock->arg);
+	}
+
+	Sim_clockUpdate();
+}
+
+void Clock_Params_init(Clock_Params* params)
+{
+	params->period    = 0;
+	params->startFlag = FALSE;
+	params->arg       = 0;
+}
+
+void Clock_construct(Clock_Struct* obj, Clock_FuncPtr fxn, UInt timeout, const Clock_Params* params)
+{
+	Clock_Params defaults;
+
+	if (!params)
+	{
+		Clock_Params_init(&defaults);
+		params = &defaults;
+	}
+
+	obj->fxn     = fxn;
+	obj->arg     = params->arg;
+	obj->timeout = timeout;
+	obj->period  = params->period;
+	obj->active  = FALSE;
+	obj->next    = NULL;
+
+	if (params->startFlag) Clock_start(obj);
+}
+
+void Clock_destruct(Clock_Struct* obj)
+{
+	Clock_stop(obj);
+}
+
+void Clock_start(Clock_Handle handle)
+{
+	Sim_spend(SIM_COST_KERNEL);
+	Sim_clockRemove(handle);
+
+	//
+	//	Timeouts count whole ticks from the current one.
+	//
+	handle->when = ((Sim_time / SIM_CLOCK_TICK) + handle->timeout) * SIM_CLOCK_TICK;
+	Sim_clockInsert(handle);
+	Sim_clockUpdate();
+}
+
+void Clock_stop(Clock_Handle handle)
+{
+	Sim_spend(SIM_COST_KERNEL);
+	Sim_clockRemove(handle);
+	Sim_clockUpdate();
+}
+
+void Clock_setTimeout(Clock_Handle handle, UInt32 timeout)
+{
+	handle->timeout = timeout;
+}
+
+void Clock_setPeriod(Clock_Handle handle, UInt32 period)
+{
+	handle->period = period;
+}
+
+Bool Clock_isActive(Clock_Handle handle)
+{
+	return handle->active;
+}
+
+UInt32 Clock_getTicks(void)
+{
+	return (UInt32)(Sim_time / SIM_CLOCK_TICK);
+}
+
+/******************************************************************************
+ *	Task.
+ ******************************************************************************/
+
+static Sim_TaskContext* Sim_context(Task_Struct* task)
+{
+	return (Sim_TaskContext*)task->context;
+}
+
+static void Sim_taskEntry(void)
+{
+	Task_Struct* task = Sim_currentTask;
+
+	task->fxn(task->arg0, task->arg1);
+	task->mode = SIM_TASK_TERMINATED;
+}
+
+//
+//	Wake a sleeping task, or a pending one whose timeout expired.
+//
+static void Sim_taskWake(UArg arg)
+{
+	Task_Struct*     task    = (Task_Struct*)arg;
+	Sim_TaskContext* context = Sim_context(task);
+	Task_Struct**    link    = NULL;
+
+	if (task->mode != SIM_TASK_BLOCKED) return;
+
+	if (context->sem)
+	{
+		link = &context->sem->pending;
+		while (*link != task) link = &(*link)->waitNext;
+		*link = task->waitNext;
+
+		context->sem = NULL;
+		task->timedOut = TRUE;
+	}
+
+	task->mode = SIM_TASK_READY;
+}
+
+static Task_Struct* Sim_nextTask(void)
+{
+	Task_Struct* task = NULL;
+	Task_Struct* best = NULL;
+
+	for (task = Sim_tasks; task; task = task->next)
+	{
+		if ((task->mode == SIM_TASK_READY) && (!best || (task->priority > best->priority))) best = task;
+	}
+
+	return best;
+}
+
+static void Sim_switchTo(Task_Struct* task)
+{
+	Sim_currentTask = task;
+	swapcontext(&Sim_idleContext, &Sim_context(task)->uc);
+	Sim_currentTask = NULL;
+}
+
+//
+//	Give the processor back to the scheduler until the task is
+//	ready again.
+//
+static Bool Sim_block(void)
+{
+	Task_Struct* task = Sim_currentTask;
+
+	if (!task || (Sim_currentLevel != SIM_LEVEL_TASK))
+	{
+		Sim_fail("blocking call outside of a task");
+		return FALSE;
+	}
+
+	task->mode = SIM_TASK_BLOCKED;
+	swapcontext(&Sim_context(task)->uc, &Sim_idleContext);
+
+	return TRUE;
+}
+
+void Task_Params_init(Task_Params* params)
+{
+	params->arg0      = 0;
+	params->arg1      = 0;
+	params->priority  = 1;
+	params->stack     = NULL;
+	params->stackSize = 0;
+}
+
+void Task_construct(Task_Struct* obj, Task_FuncPtr fxn, const Task_Params* params, void* eb)
+{
+	Task_Params      defaults;
+	Sim_TaskContext* context = NULL;
+	Task_Struct**    link    = &Sim_tasks;
+
+	if (!params)
+	{
+		Task_Params_init(&defaults);
+		params = &defaults;
+	}
+
+	obj->fxn      = fxn;
+	obj->arg0     = params->arg0;
+	obj->arg1     = params->arg1;
+	obj->priority = params->priority;
+	obj->mode     = SIM_TASK_READY;
+	obj->timedOut = FALSE;
+	obj->next     = NULL;
+	obj->waitNext = NULL;
+
+	context = calloc(1, sizeof(Sim_TaskContext));
+	obj->stack = malloc(SIM_TASK_STACK_SIZE);
+	if (!context || !obj->stack) System_abort("Error allocating task\n");
+
+	getcontext(&context->uc);
+	context->uc.uc_stack.ss_sp   = obj->stack;
+	context->uc.uc_stack.ss_size = SIM_TASK_STACK_SIZE;
+	context->uc.uc_link          = &Sim_idleContext;
+	makecontext(&context->uc, Sim_taskEntry, 0);
+	Sim_Event_init(&context->wake, Sim_taskWake, (UArg)obj, SIM_LEVEL_SWI);
+	obj->context = context;
+
+	while (*link) link = &(*link)->next;
+	*link = obj;
+}
+
+void Task_sleep(UInt32 ticks)
+{
+	Task_Struct* task = Sim_currentTask;
+
+	Sim_spend(SIM_COST_KERNEL);
+
+	if (!ticks)
+	{
+		Task_yield();
+		return;
+	}
+
+	Sim_schedule(&Sim_context(task)->wake, ((Sim_time / SIM_CLOCK_TICK) + ticks) * SIM_CLOCK_TICK);
+	Sim_block();
+}
+
+//
+//	The running task, NULL outside of the tasks.
+//
+Task_Handle Task_self(void)
+{
+	return Sim_currentTask;
+}
+
+Int Task_setPri(Task_Handle handle, Int newpri)
+{
+	Int oldpri = handle->priority;
+
+	handle->priority = newpri;
+
+	return oldpri;
+}
+
+void Task_yield(void)
+{
+	Task_Struct*  task = Sim_currentTask;
+	Task_Struct** link = &Sim_tasks;
+
+	if (!task) return;
+
+	//
+	//	Move to the back of the list, behind tasks of equal priority.
+	//
+	while (*link != task) link = &(*link)->next;
+	*link = task->next;
+	task->next = NULL;
+	while (*link) link = &(*link)->next;
+	*link = task;
+
+	swapcontext(&Sim_context(task)->uc, &Sim_idleContext);
+}
+
+/******************************************************************************
+ *	Semaphore.
+ ******************************************************************************/
+
+void Semaphore_Params_init(Semaphore_Params* params)
+{
+	params->mode = Semaphore_Mode_COUNTING;
+}
+
+void Semaphore_construct(Semaphore_Struct* obj, Int count, const Semaphore_Params* params)
+{
+	obj->mode    = params ? params->mode : Semaphore_Mode_COUNTING;
+	obj->count   = ((obj->mode == Semaphore_Mode_BINARY) && count) ? 1 : count;
+	obj->pending = NULL;
+}
+
+Bool Semaphore_pend(Semaphore_Handle handle, UInt32 timeout)
+{
+	Task_Struct*     task    = Sim_currentTask;
+	Sim_TaskContext* context = NULL;
+	Task_Struct**    link    = &handle->pending;
+
+	Sim_spend(SIM_COST_KERNEL);
+
+	if (handle->count)
+	{
+		handle->count--;
+		return TRUE;
+	}
+
+	if (timeout == BIOS_NO_WAIT) return FALSE;
+
+	//
+	//	The harness may call into the firmware after the run, the
+	//	tasks never run again and hold nothing then.
+	//
+	if (!task && Sim_stopped) return TRUE;
+
+	if (!task)
+	{
+		Sim_fail("Semaphore_pend outside of a task");
+		return FALSE;
+	}
+
+	context = Sim_context(task);
+	context->sem   = handle;
+	task->timedOut = FALSE;
+	task->waitNext = NULL;
+	while (*link) link = &(*link)->waitNext;
+	*link = task;
+
+	if (timeout != BIOS_WAIT_FOREVER)
+	{
+		Sim_schedule(&context->wake, ((Sim_time / SIM_CLOCK_TICK) + timeout) * SIM_CLOCK_TICK);
+	}
+
+	if (!Sim_block()) return FALSE;
+
+	return !task->timedOut;
+}
+
+void Semaphore_post(Semaphore_Handle handle)
+{
+	Task_Struct*     task    = NULL;
+	Sim_TaskContext* context = NULL;
+
+	Sim_spend(SIM_COST_KERNEL);
+	task = handle->pending;
+
+	if (task)
+	{
+		handle->pending = task->waitNext;
+
+		context = Sim_context(task);
+		context->sem = NULL;
+		Sim_cancel(&context->wake);
+		task->mode = SIM_TASK_READY;
+		return;
+	}
+
+	if ((handle->mode == Semaphore_Mode_BINARY) || (handle->count == 0))
+	{
+		handle->count = 1;
+	}
+	else
+	{
+		handle->count++;
+	}
+}
+
+void Semaphore_reset(Semaphore_Handle handle, Int count)
+{
+	handle->count = count;
+}
+
+Int Semaphore_getCount(Semaphore_Handle handle)
+{
+	return handle->count;
+}
+
+/******************************************************************************
+ *	BIOS and System.
+ ******************************************************************************/
+
+//
+//	The scheduler: run the highest priority ready task, otherwise
+//	idle until the next event. Tasks only switch when they block,
+//	yield or finish, a Swi that readies a task doesn't preempt the
+//	running one.
+//
+void BIOS_start(void)
+{
+	Task_Struct* task  = NULL;
+	Sim_Event*   event = NULL;
+	uint8_t      i     = 0;
+
+	while (!Sim_stopped)
+	{
+		task = Sim_nextTask();
+		if (task)
+		{
+			Sim_switchTo(task);
+			continue;
+		}
+
+		//
+		//	The idle loop, a handler that preempts it may ready a task.
+		//
+		for (i = 0; i < Sim_numIdleFxns; i++) Sim_idleFxns[i]();
+		if (Sim_nextTask()) continue;
+
+		if (!Sim_queue) break;
+
+		event = Sim_nextRunnable(~(Sim_Time)0);
+		if (!event)
+		{
+			Sim_fail("every task blocked with interrupts left masked");
+			break;
+		}
+
+		if (event->when > Sim_limit) break;
+
+		SimPower_idle(event->when);
+	}
+}
+
+Int System_printf(const char* fmt, ...)
+{
+	char    str[256];
+	va_list args;
+	Int     length = 0;
+
+	va_start(args, fmt);
+	length = vsnprintf(str, sizeof(str), fmt, args);
+	va_end(args);
+
+	Sim_spend(length * SIM_COST_CHAR);
+
+	if (Sim_output)
+	{
+		Sim_output(str);
+	}
+	else
+	{
+		fputs(str, stdout);
+	}
+
+	return length;
+}
+
+Int System_sprintf(Char* buf, const char* fmt, ...)
+{
+	va_list args;
+	Int     length = 0;
+
+	va_start(args, fmt);
+	length = vsprintf(buf, fmt, args);
+	va_end(args);
+
+	Sim_spend(length * SIM_COST_CHAR);
+
+	return length;
+}
+
+void System_flush(void)
+{
+	if (!Sim_output) fflush(stdout);
+}
+
+void System_abort(const char* str)
+{
+	fflush(stdout);
+	fprintf(stderr, "System_abort: %s", str);
+	exit(EXIT_FAILURE);
+}
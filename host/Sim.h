@@ -0,0 +1,124 @@
+#ifndef __SIM_H__
+#define __SIM_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+//
+//	Simulated time, in ticks of the 48 MHz system clock so that
+//	HRTimer_now() maps directly onto it.
+//
+typedef uint64_t Sim_Time;
+
+#define SIM_TICKS_PER_US				48
+
+#define Sim_fromMicros(us)			((Sim_Time)(us) * SIM_TICKS_PER_US)
+#define Sim_toMicros(ticks)			((ticks) / SIM_TICKS_PER_US)
+
+//
+//	Time spent by every poll of the simulated hardware (a pin or
+//	timer register read), so busy-wait loops make progress.
+//
+#define SIM_COST_IO							12
+
+//
+//	Time from a peripheral's interrupt request to its driver's
+//	callback, about 1.5 us: the 12 cycles of exception entry, the
+//	BIOS Hwi dispatcher and the driver's own handler.
+//
+#define SIM_COST_HWI_ENTRY			72
+
+//
+//	Time of a kernel call that starts, posts or blocks (Clock,
+//	Semaphore, Task), and of every character System_printf() and
+//	System_sprintf() format, so handlers take time for more than
+//	their hardware accesses.
+//
+#define SIM_COST_KERNEL					48
+#define SIM_COST_CHAR						24
+
+//
+//	Execution levels. Events at a level only run when the current
+//	level is lower and the level is not masked. External events
+//	model the outside world (sensor waveforms, sampling probes) and
+//	run regardless of the masks.
+//
+#define SIM_LEVEL_TASK					0
+#define SIM_LEVEL_SWI						1
+#define SIM_LEVEL_HWI						2
+#define SIM_LEVEL_EXT						3
+
+typedef void (*Sim_EventFxn)(UArg arg);
+
+typedef struct Sim_Event
+{
+	Sim_Time          when;
+	Sim_EventFxn      fxn;
+	UArg              arg;
+	uint8_t           level;
+	uint8_t           queued;
+	struct Sim_Event* next;
+} Sim_Event;
+
+//
+//	Output sink for System_printf(), stdout by default.
+//
+typedef void (*Sim_OutputFxn)(const char* str);
+
+//
+//	Events, the object must stay valid while queued.
+//
+void Sim_Event_init(Sim_Event* event, Sim_EventFxn fxn, UArg arg, uint8_t level);
+void Sim_schedule(Sim_Event* event, Sim_Time when);
+void Sim_cancel(Sim_Event* event);
+
+//
+//	Current simulated time and execution level.
+//
+Sim_Time Sim_now(void);
+uint8_t  Sim_level(void);
+
+//
+//	Let the running code consume the given time, events that fall
+//	due meanwhile preempt it when their level allows.
+//
+void Sim_spend(Sim_Time ticks);
+
+//
+//	Stop the scheduler, BIOS_start() returns once the running
+//	task blocks. Sim_fail() also marks the run as failed.
+//
+void Sim_stop(void);
+void Sim_fail(const char* reason);
+Bool Sim_failed(void);
+
+//
+//	Stop once simulated time would pass the limit.
+//
+void Sim_setLimit(Sim_Time limit);
+
+void Sim_setOutput(Sim_OutputFxn fxn);
+
+//
+//	Longest time Swis stayed disabled, every Clock and Swi handler
+//	may run that late.
+//
+Sim_Time Sim_getLongestSwiMask(void);
+
+//
+//	Idle functions, run every time the scheduler goes idle before it
+//	sleeps, as the .cfg's Idle.addFunc() list.
+//
+#define SIM_MAX_IDLE_FXNS				4
+
+typedef void (*Sim_IdleFxn)(void);
+
+void Sim_addIdleFunc(Sim_IdleFxn fxn);
+
+#endif
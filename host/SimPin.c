@@ -0,0 +1,434 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+
+#include <driverlib/ioc.h>
+
+#include "Sim.h"
+#include "SimPin.h"
+
+#define SIMPIN_MAX_WATCHERS			4
+
+//
+//	MCU port events, the GPTimer outputs.
+//
+#define SIMPIN_NUM_EVENTS				8
+
+#define SimPin_bit(pinId)				((uint32_t)1 << (pinId))
+
+//
+//	Pin configuration as set by PIN_init(), restored on PIN_close(),
+//	and the configuration in effect.
+//
+static PIN_Config SimPin_default[SIMPIN_NUM_PINS];
+static PIN_Config SimPin_config[SIMPIN_NUM_PINS];
+static PIN_Handle SimPin_owner[SIMPIN_NUM_PINS];
+
+//
+//	Output register, lines pulled low by simulated devices and the
+//	resulting line levels.
+//
+static uint32_t SimPin_outputs;
+static uint32_t SimPin_external;
+static uint32_t SimPin_lines = ~(uint32_t)0;
+
+//
+//	Port each pin is muxed to, and the levels of the port events.
+//	A pin muxed away from the GPIO outputs what its port drives.
+//
+static int32_t  SimPin_mux[SIMPIN_NUM_PINS];
+static uint32_t SimPin_events;
+
+//
+//	Pending edge interrupt per pin, several edges while one is
+//	pending collapse into one callback as on the real IOC.
+//
+static Sim_Event SimPin_irq[SIMPIN_NUM_PINS];
+static Bool      SimPin_irqInit;
+
+static SimPin_LineFxn  SimPin_lineWatchers[SIMPIN_MAX_WATCHERS];
+static SimPin_WriteFxn SimPin_writeWatchers[SIMPIN_MAX_WATCHERS];
+
+static void SimPin_irqFxn(UArg arg)
+{
+	PIN_Id     pinId  = (PIN_Id)arg;
+	PIN_Handle handle = SimPin_owner[pinId];
+
+	if (handle && handle->callbackFxn) handle->callbackFxn(handle, pinId);
+}
+
+static Bool SimPin_isEvent(int32_t port)
+{
+	return (port >= IOC_PORT_MCU_PORT_EVENT0) && (port < IOC_PORT_MCU_PORT_EVENT0 + SIMPIN_NUM_EVENTS);
+}
+
+//
+//	Output word as driven onto the pins, the output register for
+//	GPIO pins and the port event levels for muxed ones.
+//
+static uint32_t SimPin_driven(void)
+{
+	uint32_t outputs = SimPin_outputs;
+	PIN_Id   pinId   = 0;
+
+	for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++)
+	{
+		if (SimPin_mux[pinId] == IOC_PORT_GPIO) continue;
+
+		outputs &= ~SimPin_bit(pinId);
+		if (SimPin_isEvent(SimPin_mux[pinId]) && ((SimPin_events >> (SimPin_mux[pinId] - IOC_PORT_MCU_PORT_EVENT0)) & 1))
+		{
+			outputs |= SimPin_bit(pinId);
+		}
+	}
+
+	return outputs;
+}
+
+//
+//	Level of one line: an enabled output driving it wins, then an
+//	external device pulling it low, then the pull resistor.
+//
+static uint32_t SimPin_level(PIN_Id pinId, uint32_t outputs)
+{
+	PIN_Config config = SimPin_config[pinId];
+	uint32_t   bit    = SimPin_bit(pinId);
+
+	if (config & PIN_GPIO_OUTPUT_EN)
+	{
+		if (!(outputs & bit) && !(config & PIN_OPENSOURCE)) return 0;
+		if ((outputs & bit) && !(config & PIN_OPENDRAIN)) return bit;
+	}
+
+	if (SimPin_external & bit) return 0;
+	if ((config & PIN_BM_PULLING) == PIN_PULLDOWN) return 0;
+
+	return bit;
+}
+
+static void SimPin_update(void)
+{
+	uint32_t   lines   = 0, changed = 0, bit = 0;
+	uint32_t   outputs = SimPin_driven();
+	PIN_Id     pinId   = 0;
+	PIN_Config irq     = 0;
+	uint8_t    i       = 0;
+
+	for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++) lines |= SimPin_level(pinId, outputs);
+
+	changed = lines ^ SimPin_lines;
+	SimPin_lines = lines;
+	if (!changed) return;
+
+	//
+	//	Raise the edge interrupts of the changed lines.
+	//
+	for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++)
+	{
+		bit = SimPin_bit(pinId);
+		if (!(changed & bit) || !SimPin_owner[pinId]) continue;
+
+		irq = SimPin_config[pinId] & PIN_BM_IRQ;
+		if (((lines & bit) && (irq & PIN_IRQ_POSEDGE)) || (!(lines & bit) && (irq & PIN_IRQ_NEGEDGE)))
+		{
+			if (!SimPin_irq[pinId].queued) Sim_schedule(&SimPin_irq[pinId], Sim_now());
+		}
+	}
+
+	for (i = 0; (i < SIMPIN_MAX_WATCHERS) && SimPin_lineWatchers[i]; i++) SimPin_lineWatchers[i](changed, lines);
+}
+
+static void SimPin_written(uint32_t written)
+{
+	uint32_t outputs = SimPin_driven();
+	uint8_t  i       = 0;
+
+	for (i = 0; (i < SIMPIN_MAX_WATCHERS) && SimPin_writeWatchers[i]; i++) SimPin_writeWatchers[i](written, outputs);
+
+	SimPin_update();
+}
+
+static void SimPin_apply(PIN_Config config)
+{
+	PIN_Id pinId = PIN_ID(config);
+
+	SimPin_config[pinId] = config;
+
+	if (config & PIN_GPIO_HIGH)
+	{
+		SimPin_outputs |= SimPin_bit(pinId);
+	}
+	else
+	{
+		SimPin_outputs &= ~SimPin_bit(pinId);
+	}
+}
+
+PIN_Status PIN_init(const PIN_Config pinConfig[])
+{
+	PIN_Id  pinId = 0;
+	uint8_t i     = 0;
+
+	if (!SimPin_irqInit)
+	{
+		for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++)
+		{
+			Sim_Event_init(&SimPin_irq[pinId], SimPin_irqFxn, pinId, SIM_LEVEL_SWI);
+			SimPin_config[pinId] = pinId | PIN_INPUT_EN | PIN_NOPULL;
+			SimPin_default[pinId] = SimPin_config[pinId];
+		}
+		SimPin_irqInit = TRUE;
+	}
+
+	for (i = 0; PIN_ID(pinConfig[i]) != PIN_TERMINATE; i++)
+	{
+		if (PIN_ID(pinConfig[i]) >= SIMPIN_NUM_PINS) return PIN_NO_ACCESS;
+
+		SimPin_default[PIN_ID(pinConfig[i])] = pinConfig[i];
+		SimPin_apply(pinConfig[i]);
+	}
+
+	SimPin_update();
+
+	return PIN_SUCCESS;
+}
+
+PIN_Handle PIN_open(PIN_State* state, const PIN_Config pinList[])
+{
+	uint8_t i = 0;
+
+	//
+	//	All or nothing, like the real driver.
+	//
+	for (i = 0; PIN_ID(pinList[i]) != PIN_TERMINATE; i++)
+	{
+		if ((PIN_ID(pinList[i]) >= SIMPIN_NUM_PINS) || SimPin_owner[PIN_ID(pinList[i])]) return NULL;
+	}
+
+	state->portMask    = 0;
+	state->callbackFxn = NULL;
+	state->userArg     = 0;
+
+	for (i = 0; PIN_ID(pinList[i]) != PIN_TERMINATE; i++)
+	{
+		SimPin_owner[PIN_ID(pinList[i])] = state;
+		state->portMask |= SimPin_bit(PIN_ID(pinList[i]));
+		SimPin_apply(pinList[i]);
+	}
+
+	SimPin_update();
+
+	return state;
+}
+
+void PIN_close(PIN_Handle handle)
+{
+	PIN_Id pinId = 0;
+
+	for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++)
+	{
+		if (SimPin_owner[pinId] != handle) continue;
+
+		SimPin_owner[pinId] = NULL;
+		SimPin_mux[pinId] = IOC_PORT_GPIO;
+		Sim_cancel(&SimPin_irq[pinId]);
+		SimPin_apply(SimPin_default[pinId]);
+	}
+
+	handle->portMask = 0;
+	SimPin_update();
+}
+
+PIN_Status PIN_setConfig(PIN_Handle handle, PIN_Config updateMask, PIN_Config pinCfg)
+{
+	PIN_Id pinId = PIN_ID(pinCfg);
+
+	if (!(handle->portMask & SimPin_bit(pinId))) return PIN_NO_ACCESS;
+
+	SimPin_config[pinId] = (SimPin_config[pinId] & ~updateMask & ~0xFF) | (pinCfg & updateMask & ~0xFF) | pinId;
+
+	if (updateMask & PIN_BM_GPIO_OUTPUT_VAL)
+	{
+		PIN_setOutputValue(handle, pinId, (pinCfg & PIN_GPIO_HIGH) ? 1 : 0);
+	}
+	else
+	{
+		SimPin_update();
+	}
+
+	return PIN_SUCCESS;
+}
+
+PIN_Status PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint_fast8_t val)
+{
+	Sim_spend(SIM_COST_IO);
+
+	if (!(handle->portMask & SimPin_bit(pinId))) return PIN_NO_ACCESS;
+
+	if (val)
+	{
+		SimPin_outputs |= SimPin_bit(pinId);
+	}
+	else
+	{
+		SimPin_outputs &= ~SimPin_bit(pinId);
+	}
+
+	SimPin_written(SimPin_bit(pinId));
+
+	return PIN_SUCCESS;
+}
+
+uint_fast8_t PIN_getOutputValue(PIN_Id pinId)
+{
+	return (SimPin_outputs >> pinId) & 1;
+}
+
+uint_fast8_t PIN_getInputValue(PIN_Id pinId)
+{
+	Sim_spend(SIM_COST_IO);
+
+	if (SimPin_config[pinId] & PIN_INPUT_DIS) return 0;
+
+	return (SimPin_lines >> pinId) & 1;
+}
+
+PIN_Status PIN_setPortOutputValue(PIN_Handle handle, uint_fast32_t outputValueMask)
+{
+	Sim_spend(SIM_COST_IO);
+
+	SimPin_outputs = (SimPin_outputs & ~handle->portMask) | (outputValueMask & handle->portMask);
+	SimPin_written(handle->portMask);
+
+	return PIN_SUCCESS;
+}
+
+uint_fast32_t PIN_getPortOutputValue(PIN_Handle handle)
+{
+	return SimPin_outputs & handle->portMask;
+}
+
+uint_fast32_t PIN_getPortInputValue(PIN_Handle handle)
+{
+	Sim_spend(SIM_COST_IO);
+
+	return SimPin_lines & handle->portMask;
+}
+
+uint_fast32_t PIN_getPortMask(PIN_Handle handle)
+{
+	return handle->portMask;
+}
+
+PIN_Status PIN_registerIntCb(PIN_Handle handle, PIN_IntCb callbackFxn)
+{
+	handle->callbackFxn = callbackFxn;
+
+	return PIN_SUCCESS;
+}
+
+PIN_Status PIN_setInterrupt(PIN_Handle handle, PIN_Config pinCfg)
+{
+	PIN_Id pinId = PIN_ID(pinCfg);
+
+	if (!(handle->portMask & SimPin_bit(pinId))) return PIN_NO_ACCESS;
+
+	SimPin_config[pinId] = (SimPin_config[pinId] & ~PIN_BM_IRQ) | (pinCfg & PIN_BM_IRQ);
+
+	//
+	//	Enabling or disabling clears an edge left pending.
+	//
+	Sim_cancel(&SimPin_irq[pinId]);
+
+	return PIN_SUCCESS;
+}
+
+PIN_Status PINCC26XX_setMux(PIN_Handle handle, PIN_Id pinId, int32_t nMux)
+{
+	Sim_spend(SIM_COST_IO);
+
+	if (!(handle->portMask & SimPin_bit(pinId))) return PIN_NO_ACCESS;
+
+	SimPin_mux[pinId] = (nMux < 0) ? IOC_PORT_GPIO : nMux;
+	SimPin_written(SimPin_bit(pinId));
+
+	return PIN_SUCCESS;
+}
+
+int32_t PINCC26XX_getMux(PIN_Id pinId)
+{
+	return SimPin_mux[pinId];
+}
+
+void SimPin_drive(PIN_Id pinId, Bool low)
+{
+	SimPin_drivePins(SimPin_bit(pinId), low);
+}
+
+void SimPin_drivePins(uint32_t pins, Bool low)
+{
+	if (low)
+	{
+		SimPin_external |= pins;
+	}
+	else
+	{
+		SimPin_external &= ~pins;
+	}
+
+	SimPin_update();
+}
+
+uint32_t SimPin_getLines(void)
+{
+	return SimPin_lines;
+}
+
+void SimPin_setEvent(int32_t port, Bool high)
+{
+	uint32_t written = 0, bit = 0;
+	PIN_Id   pinId   = 0;
+
+	if (!SimPin_isEvent(port)) return;
+
+	bit = (uint32_t)1 << (port - IOC_PORT_MCU_PORT_EVENT0);
+	if (high == !!(SimPin_events & bit)) return;
+
+	SimPin_events ^= bit;
+
+	for (pinId = 0; pinId < SIMPIN_NUM_PINS; pinId++)
+	{
+		if (SimPin_mux[pinId] == port) written |= SimPin_bit(pinId);
+	}
+
+	//
+	//	The peripheral drives the pins, watchers see it like a write.
+	//
+	if (written) SimPin_written(written);
+}
+
+void SimPin_watchLines(SimPin_LineFxn fxn)
+{
+	uint8_t i = 0;
+
+	while ((i < SIMPIN_MAX_WATCHERS) && SimPin_lineWatchers[i]) i++;
+	if (i < SIMPIN_MAX_WATCHERS) SimPin_lineWatchers[i] = fxn;
+}
+
+void SimPin_watchWrites(SimPin_WriteFxn fxn)
+{
+	uint8_t i = 0;
+
+	while ((i < SIMPIN_MAX_WATCHERS) && SimPin_writeWatchers[i]) i++;
+	if (i < SIMPIN_MAX_WATCHERS) SimPin_writeWatchers[i] = fxn;
+}
@@ -0,0 +1,54 @@
+#ifndef __SIMPIN_H__
+#define __SIMPIN_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+//
+//	Number of simulated IOs, enough for the CC2650 7x7 package.
+//
+#define SIMPIN_NUM_PINS					32
+
+//
+//	Called whenever the level of any line changes, with the changed
+//	lines and the new levels, one bit per pin id.
+//
+typedef void (*SimPin_LineFxn)(uint32_t changed, uint32_t lines);
+
+//
+//	Called for every firmware write to the output register, and
+//	every level change a peripheral drives onto a muxed pin, with
+//	the pins written and the resulting output word.
+//
+typedef void (*SimPin_WriteFxn)(uint32_t written, uint32_t outputs);
+
+//
+//	Let a simulated device pull a line low, or release it. Lines
+//	without a driver float high through the board pull-ups.
+//
+void SimPin_drive(PIN_Id pinId, Bool low);
+
+//
+//	The same for several lines at once (one bit per pin id), they
+//	change level together.
+//
+void SimPin_drivePins(uint32_t pins, Bool low);
+
+uint32_t SimPin_getLines(void);
+
+//
+//	Set the level a peripheral drives on one of its IOC port events,
+//	the pins muxed to it follow (driverlib/ioc.h port ids).
+//
+void SimPin_setEvent(int32_t port, Bool high);
+
+void SimPin_watchLines(SimPin_LineFxn fxn);
+void SimPin_watchWrites(SimPin_WriteFxn fxn);
+
+#endif
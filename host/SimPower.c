@@ -0,0 +1,96 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include "Sim.h"
+#include "SimPower.h"
+
+static uint8_t        SimPower_constraints[PowerCC26XX_NUMCONSTRAINTS];
+static SimPower_Stats SimPower_stats;
+
+void Power_init(void)
+{
+}
+
+int_fast16_t Power_setConstraint(uint_fast16_t constraintId)
+{
+	if (constraintId >= PowerCC26XX_NUMCONSTRAINTS) return Power_EFAIL;
+
+	SimPower_constraints[constraintId]++;
+
+	return Power_SUCCESS;
+}
+
+int_fast16_t Power_releaseConstraint(uint_fast16_t constraintId)
+{
+	//
+	//	Releasing a constraint nobody holds is a firmware bug.
+	//
+	if ((constraintId >= PowerCC26XX_NUMCONSTRAINTS) || !SimPower_constraints[constraintId])
+	{
+		Sim_fail("Power_releaseConstraint() of a constraint not set");
+		return Power_EFAIL;
+	}
+
+	SimPower_constraints[constraintId]--;
+
+	return Power_SUCCESS;
+}
+
+uint_fast32_t Power_getConstraintMask(void)
+{
+	uint_fast32_t mask = 0;
+	uint8_t       i    = 0;
+
+	for (i = 0; i < PowerCC26XX_NUMCONSTRAINTS; i++)
+	{
+		if (SimPower_constraints[i]) mask |= (uint_fast32_t)1 << i;
+	}
+
+	return mask;
+}
+
+void SimPower_idle(Sim_Time until)
+{
+	Sim_Time now = Sim_now();
+	Sim_Time asleep = (until > now) ? (until - now) : 0;
+
+	//
+	//	The wakeup handlers run at the end of the sleep, their time
+	//	counts as active.
+	//
+	if (!SimPower_constraints[PowerCC26XX_SB_DISALLOW] && (asleep >= Sim_fromMicros(SIMPOWER_STANDBY_MIN_US)))
+	{
+		SimPower_stats.standby += asleep;
+	}
+	else
+	{
+		SimPower_stats.idle += asleep;
+	}
+
+	Sim_spend(asleep);
+}
+
+const SimPower_Stats* SimPower_getStats(void)
+{
+	SimPower_stats.active = Sim_now() - SimPower_stats.idle - SimPower_stats.standby;
+
+	return &SimPower_stats;
+}
+
+uint32_t SimPower_getCurrent(void)
+{
+	const SimPower_Stats* stats = SimPower_getStats();
+	Sim_Time total = Sim_now();
+
+	if (!total) return 0;
+
+	return (uint32_t)(((stats->active * SIMPOWER_ACTIVE_UA) + (stats->idle * SIMPOWER_IDLE_UA) +
+	                   (stats->standby * SIMPOWER_STANDBY_UA)) / total);
+}
@@ -0,0 +1,46 @@
+#ifndef __SIMPOWER_H__
+#define __SIMPOWER_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+
+#include "Sim.h"
+
+//
+//	Power states of the simulated CC2650 and their supply current,
+//	from the datasheet: CPU running at 48 MHz, idle with the CPU
+//	stopped and the peripherals powered, and standby with only the
+//	RTC and retention left.
+//
+#define SIMPOWER_ACTIVE_UA			2940
+#define SIMPOWER_IDLE_UA				550
+#define SIMPOWER_STANDBY_UA			1
+
+//
+//	The standby policy only sleeps when the next wakeup is at least
+//	this far, it covers the entry and exit.
+//
+#define SIMPOWER_STANDBY_MIN_US	1000
+
+typedef struct SimPower_Stats
+{
+	Sim_Time active;
+	Sim_Time idle;
+	Sim_Time standby;
+} SimPower_Stats;
+
+//
+//	Called by the scheduler with no task ready, sleeps until the
+//	given time in idle or standby as the constraints allow.
+//
+void SimPower_idle(Sim_Time until);
+
+//
+//	Time in every state since the start, and the average current.
+//
+const SimPower_Stats* SimPower_getStats(void);
+uint32_t SimPower_getCurrent(void);
+
+#endif
@@ -0,0 +1,264 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <string.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include <driverlib/aon_rtc.h>
+
+#include "Sim.h"
+#include "SimPin.h"
+
+//
+//	Timer halves, 0A to 3B as in the board file. A 32 bit timer is
+//	opened on its A half.
+//
+#define SIMTIMER_NUM_TIMERS			8
+
+struct GPTimerCC26XX_Object
+{
+	unsigned int          index;
+	Bool                  open;
+	Bool                  running;
+	GPTimerCC26XX_Mode    mode;
+
+	//
+	//	Values written by the firmware, and the ones latched for the
+	//	running cycle. A new load or match takes effect on the next
+	//	timeout, as on the real timer.
+	//
+	GPTimerCC26XX_Value   load;
+	GPTimerCC26XX_Value   match;
+	GPTimerCC26XX_Value   cycleLoad;
+	GPTimerCC26XX_Value   cycleMatch;
+	Sim_Time              cycleStart;
+
+	//
+	//	PWM output, high from the timeout down to the match.
+	//
+	Bool                  output;
+
+	GPTimerCC26XX_HwiFxn  callback;
+	GPTimerCC26XX_IntMask enabled;
+	GPTimerCC26XX_IntMask pending;
+
+	Sim_Event             edge;
+	Sim_Event             irq;
+};
+
+static struct GPTimerCC26XX_Object SimTimer_objects[SIMTIMER_NUM_TIMERS];
+
+static void SimTimer_raise(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask mask)
+{
+	if (!(handle->enabled & mask)) return;
+
+	handle->pending |= mask;
+	if (!handle->irq.queued) Sim_schedule(&handle->irq, Sim_now() + SIM_COST_HWI_ENTRY);
+}
+
+static void SimTimer_irqFxn(UArg arg)
+{
+	GPTimerCC26XX_Handle  handle = (GPTimerCC26XX_Handle)arg;
+	GPTimerCC26XX_IntMask mask   = handle->pending;
+
+	handle->pending = 0;
+	if (handle->callback && mask) handle->callback(handle, mask);
+}
+
+static void SimTimer_setOutput(GPTimerCC26XX_Handle handle, Bool high)
+{
+	if (handle->output == high) return;
+
+	handle->output = high;
+	SimPin_setEvent(GPTimerCC26XX_getPinMux(handle), high);
+}
+
+//
+//	Runs at every timeout and, in PWM mode, at every match. The
+//	counter reloads every load + 1 ticks, PWM counts down so the
+//	output stays high for load - match ticks.
+//
+static void SimTimer_edgeFxn(UArg arg)
+{
+	GPTimerCC26XX_Handle handle = (GPTimerCC26XX_Handle)arg;
+	Sim_Time now = Sim_now();
+
+	if ((handle->mode == GPT_MODE_PWM) && handle->output && (now < handle->cycleStart + handle->cycleLoad + 1))
+	{
+		SimTimer_setOutput(handle, FALSE);
+		Sim_schedule(&handle->edge, handle->cycleStart + handle->cycleLoad + 1);
+		SimTimer_raise(handle, GPT_INT_MATCH);
+		return;
+	}
+
+	handle->cycleStart = now;
+	handle->cycleLoad  = handle->load;
+	handle->cycleMatch = handle->match;
+
+	if (handle->mode == GPT_MODE_PWM)
+	{
+		if (handle->cycleMatch < handle->cycleLoad)
+		{
+			SimTimer_setOutput(handle, TRUE);
+			Sim_schedule(&handle->edge, now + handle->cycleLoad - handle->cycleMatch);
+		}
+		else
+		{
+			SimTimer_setOutput(handle, FALSE);
+			Sim_schedule(&handle->edge, now + handle->cycleLoad + 1);
+		}
+	}
+	else if (handle->mode != GPT_MODE_ONESHOT_UP)
+	{
+		Sim_schedule(&handle->edge, now + handle->cycleLoad + 1);
+	}
+
+	//
+	//	The first cycle starts on GPTimerCC26XX_start(), the timeout
+	//	is at its end.
+	//
+	if (handle->running) SimTimer_raise(handle, GPT_INT_TIMEOUT);
+	handle->running = TRUE;
+}
+
+void GPTimerCC26XX_Params_init(GPTimerCC26XX_Params* params)
+{
+	params->width          = GPT_CONFIG_16BIT;
+	params->mode           = GPT_MODE_PERIODIC_UP;
+	params->debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+}
+
+GPTimerCC26XX_Handle GPTimerCC26XX_open(unsigned int index, const GPTimerCC26XX_Params* params)
+{
+	GPTimerCC26XX_Handle handle = NULL;
+
+	if ((index >= SIMTIMER_NUM_TIMERS) || SimTimer_objects[index].open) return NULL;
+
+	//
+	//	A 32 bit timer takes both halves.
+	//
+	if (params->width == GPT_CONFIG_32BIT)
+	{
+		if ((index & 1) || SimTimer_objects[index + 1].open) return NULL;
+		SimTimer_objects[index + 1].open = TRUE;
+	}
+
+	handle = &SimTimer_objects[index];
+	memset(handle, 0, sizeof(*handle));
+	handle->index = index;
+	handle->open  = TRUE;
+	handle->mode  = params->mode;
+
+	Sim_Event_init(&handle->edge, SimTimer_edgeFxn, (UArg)handle, SIM_LEVEL_EXT);
+	Sim_Event_init(&handle->irq, SimTimer_irqFxn, (UArg)handle, SIM_LEVEL_HWI);
+
+	return handle;
+}
+
+void GPTimerCC26XX_close(GPTimerCC26XX_Handle handle)
+{
+	GPTimerCC26XX_stop(handle);
+
+	if ((handle->index + 1 < SIMTIMER_NUM_TIMERS) && !(handle->index & 1)) SimTimer_objects[handle->index + 1].open = FALSE;
+	handle->open = FALSE;
+}
+
+void GPTimerCC26XX_start(GPTimerCC26XX_Handle handle)
+{
+	if (handle->running) return;
+
+	//
+	//	The timers stop in standby, the driver keeps the device out
+	//	of it while one runs.
+	//
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+	SimTimer_edgeFxn((UArg)handle);
+}
+
+void GPTimerCC26XX_stop(GPTimerCC26XX_Handle handle)
+{
+	if (handle->running) Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+
+	Sim_cancel(&handle->edge);
+	Sim_cancel(&handle->irq);
+	handle->pending = 0;
+	handle->running = FALSE;
+	SimTimer_setOutput(handle, FALSE);
+}
+
+void GPTimerCC26XX_setLoadValue(GPTimerCC26XX_Handle handle, GPTimerCC26XX_Value loadValue)
+{
+	handle->load = loadValue;
+}
+
+void GPTimerCC26XX_setMatchValue(GPTimerCC26XX_Handle handle, GPTimerCC26XX_Value matchValue)
+{
+	handle->match = matchValue;
+}
+
+GPTimerCC26XX_Value GPTimerCC26XX_getFreeRunValue(GPTimerCC26XX_Handle handle)
+{
+	Sim_Time elapsed = 0;
+
+	//
+	//	A register read, it takes time like the pins.
+	//
+	Sim_spend(SIM_COST_IO);
+
+	if (!handle->running) return 0;
+
+	elapsed = Sim_now() - handle->cycleStart;
+	if (elapsed > handle->cycleLoad) elapsed = handle->cycleLoad;
+
+	return (handle->mode == GPT_MODE_PWM) ? (GPTimerCC26XX_Value)(handle->cycleLoad - elapsed) : (GPTimerCC26XX_Value)elapsed;
+}
+
+void GPTimerCC26XX_registerInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_HwiFxn callback, GPTimerCC26XX_IntMask intMask)
+{
+	handle->callback = callback;
+	handle->enabled  = intMask;
+}
+
+void GPTimerCC26XX_unregisterInterrupt(GPTimerCC26XX_Handle handle)
+{
+	handle->callback = NULL;
+	handle->enabled  = 0;
+	Sim_cancel(&handle->irq);
+}
+
+void GPTimerCC26XX_enableInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask intMask)
+{
+	handle->enabled |= intMask;
+}
+
+void GPTimerCC26XX_disableInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask intMask)
+{
+	handle->enabled &= ~intMask;
+	handle->pending &= ~intMask;
+}
+
+GPTimerCC26XX_PinMux GPTimerCC26XX_getPinMux(GPTimerCC26XX_Handle handle)
+{
+	return (GPTimerCC26XX_PinMux)(IOC_PORT_MCU_PORT_EVENT0 + handle->index);
+}
+
+//
+//	The RTC counts simulated time from 0 in 1/32768 s steps, the
+//	compare value holds them in 1/65536 s.
+//
+uint32_t AONRTCCurrentCompareValueGet(void)
+{
+	Sim_spend(SIM_COST_IO);
+
+	return (uint32_t)(((Sim_now() * 32768) / Sim_fromMicros(1000000)) << 1);
+}
@@ -0,0 +1,193 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Task.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/UART.h>
+#include <ti/drivers/Power.h>
+#include <ti/drivers/power/PowerCC26XX.h>
+
+#include "Sim.h"
+#include "SimUart.h"
+
+#define SIMUART_NUM_UARTS				1
+#define SIMUART_LINE_SIZE				256
+
+//
+//	A start bit, 8 data bits and a stop bit per byte.
+//
+#define SIMUART_BITS_PER_BYTE		10
+
+struct UART_Config
+{
+	Bool             open;
+	Bool             writing;
+	uint32_t         baudRate;
+	Semaphore_Struct rxSemStruct;
+	Semaphore_Struct txSemStruct;
+	Sim_Event        txDone;
+};
+
+static struct UART_Config SimUart_objects[SIMUART_NUM_UARTS];
+
+static SimUart_LineFxn SimUart_lineFxn;
+static char            SimUart_line[SIMUART_LINE_SIZE];
+static size_t          SimUart_length;
+
+//
+//	Byte on its way in, to UART 0.
+//
+static Sim_Event SimUart_rxEvent;
+static char      SimUart_rxByte;
+
+void SimUart_watch(SimUart_LineFxn fxn)
+{
+	SimUart_lineFxn = fxn;
+}
+
+static void SimUart_rxFxn(UArg arg)
+{
+	if (SimUart_objects[0].open) Semaphore_post(Semaphore_handle(&SimUart_objects[0].rxSemStruct));
+}
+
+void SimUart_receive(Sim_Time when, char byte)
+{
+	SimUart_rxByte = byte;
+	Sim_Event_init(&SimUart_rxEvent, SimUart_rxFxn, 0, SIM_LEVEL_HWI);
+	Sim_schedule(&SimUart_rxEvent, when);
+}
+
+void UART_init(void)
+{
+}
+
+void UART_Params_init(UART_Params* params)
+{
+	params->readMode      = UART_MODE_BLOCKING;
+	params->writeMode     = UART_MODE_BLOCKING;
+	params->readDataMode  = UART_DATA_TEXT;
+	params->writeDataMode = UART_DATA_TEXT;
+	params->readEcho      = UART_ECHO_ON;
+	params->baudRate      = 115200;
+}
+
+//
+//	End of transmission interrupt, the writer goes on.
+//
+static void SimUart_txDoneFxn(UArg arg)
+{
+	UART_Handle handle = (UART_Handle)arg;
+
+	Semaphore_post(Semaphore_handle(&handle->txSemStruct));
+}
+
+UART_Handle UART_open(unsigned int index, UART_Params* params)
+{
+	if ((index >= SIMUART_NUM_UARTS) || SimUart_objects[index].open) return NULL;
+
+	SimUart_objects[index].open     = TRUE;
+	SimUart_objects[index].baudRate = params->baudRate;
+	Semaphore_construct(&SimUart_objects[index].rxSemStruct, 0, NULL);
+	Semaphore_construct(&SimUart_objects[index].txSemStruct, 0, NULL);
+	Sim_Event_init(&SimUart_objects[index].txDone, SimUart_txDoneFxn, (UArg)&SimUart_objects[index], SIM_LEVEL_HWI);
+
+	return &SimUart_objects[index];
+}
+
+void UART_close(UART_Handle handle)
+{
+	handle->open = FALSE;
+}
+
+//
+//	The harness gets the bytes at once. A writing task then blocks
+//	for the time they take on the line, other threads run meanwhile.
+//	The driver fails a write while another one is in progress, and
+//	keeps the device out of standby while it transmits. Outside of
+//	the tasks (the harness) nothing waits.
+//
+int UART_write(UART_Handle handle, const void* buffer, size_t size)
+{
+	const char* bytes = buffer;
+	Bool   task = (Task_self() != NULL) && (Sim_level() == SIM_LEVEL_TASK);
+	size_t i = 0;
+
+	if (task && handle->writing)
+	{
+		Sim_fail("UART write while another is in progress");
+		return UART_ERROR;
+	}
+
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+	Sim_spend(SIM_COST_IO);
+
+	for (i = 0; i < size; i++)
+	{
+		if ((bytes[i] != '\n') && (SimUart_length < SIMUART_LINE_SIZE - 1))
+		{
+			SimUart_line[SimUart_length++] = bytes[i];
+			continue;
+		}
+
+		if (bytes[i] != '\n') continue;
+
+		SimUart_line[SimUart_length] = '\0';
+		SimUart_length = 0;
+
+		if (SimUart_lineFxn)
+		{
+			SimUart_lineFxn(SimUart_line);
+		}
+		else
+		{
+			puts(SimUart_line);
+		}
+	}
+
+	if (task)
+	{
+		handle->writing = TRUE;
+		Sim_schedule(&handle->txDone,
+		             Sim_now() + Sim_fromMicros(((uint64_t)size * SIMUART_BITS_PER_BYTE * 1000000) / handle->baudRate));
+		Semaphore_pend(Semaphore_handle(&handle->txSemStruct), BIOS_WAIT_FOREVER);
+		handle->writing = FALSE;
+	}
+
+	Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+
+	return (int)size;
+}
+
+//
+//	A read blocks until the harness sends a byte, and returns that
+//	byte alone. The driver keeps the device out of standby while it
+//	waits.
+//
+int UART_read(UART_Handle handle, void* buffer, size_t size)
+{
+	Bool received = FALSE;
+
+	Power_setConstraint(PowerCC26XX_SB_DISALLOW);
+	received = Semaphore_pend(Semaphore_handle(&handle->rxSemStruct), BIOS_WAIT_FOREVER);
+	Power_releaseConstraint(PowerCC26XX_SB_DISALLOW);
+
+	if (!received || !size) return 0;
+
+	*(char*)buffer = SimUart_rxByte;
+
+	return 1;
+}
@@ -0,0 +1,19 @@
+#ifndef __SIMUART_H__
+#define __SIMUART_H__
+
+#include "Sim.h"
+
+//
+//	Simulated UART, what the firmware writes comes out line by line
+//	to a harness, or to stdout.
+//
+typedef void (*SimUart_LineFxn)(const char* line);
+
+void SimUart_watch(SimUart_LineFxn fxn);
+
+//
+//	Receive a byte at the given time, a blocked read returns it.
+//
+void SimUart_receive(Sim_Time when, char byte);
+
+#endif
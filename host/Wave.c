@@ -0,0 +1,329 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+#include "Sim.h"
+#include "SimPin.h"
+#include "Wave.h"
+
+//
+//	Line toggles of a complete frame: the 83 edges the host times
+//	plus the release of the line after the last bit.
+//
+#define WAVE_NUM_TOGGLES				(WAVE_NUM_EDGES + 1)
+
+//
+//	Sensors on the port, every one answers on its own pin.
+//
+typedef struct Wave_Sensor
+{
+	Wave_Params params;
+	Sim_Event   event;
+
+	//
+	//	The line held low after the host released it, rising late.
+	//
+	Sim_Event   holdEvent;
+	Bool        holding;
+
+	//
+	//	Delay before every toggle of the frame being sent.
+	//
+	Sim_Time    delays[WAVE_NUM_TOGGLES];
+	uint8_t     numToggles;
+	uint8_t     toggle;
+	Bool        busy;
+	Sim_Time    fallTime;
+
+	//
+	//	Start of the last start pulse long enough to count.
+	//
+	Bool        started;
+	Sim_Time    startTime;
+} Wave_Sensor;
+
+static Wave_Sensor Wave_sensors[WAVE_MAX_SENSORS];
+static uint8_t     Wave_numSensors;
+static Wave_Stats  Wave_stats;
+
+static Sim_Time Wave_duration(Wave_Params* params, uint32_t us)
+{
+	Sim_Time duration = Sim_fromMicros(us * params->scalePercent) / 100;
+	uint32_t jitter   = Sim_fromMicros(params->jitterUs);
+
+	if (jitter)
+	{
+		duration += (rand_r(&params->seed) % ((2 * jitter) + 1));
+		duration  = (duration > jitter) ? (duration - jitter) : 1;
+	}
+
+	return duration;
+}
+
+//
+//	Delay before every toggle of a complete frame.
+//
+static void Wave_plan(Wave_Params* params, const Wave_Frame* frame, Sim_Time* delays)
+{
+	uint8_t  i = 0;
+	Bool     bit = FALSE;
+	Sim_Time rise = 0;
+
+	delays[0] = Wave_duration(params, params->goUs);
+	delays[1] = Wave_duration(params, params->responseLowUs);
+	delays[2] = Wave_duration(params, params->responseHighUs);
+
+	for (i = 0; i < (WAVE_NUM_BYTES * 8); i++)
+	{
+		bit = (frame->bytes[i / 8] >> (7 - (i % 8))) & 1;
+
+		delays[3 + (2 * i)] = Wave_duration(params, params->bitLowUs);
+		delays[4 + (2 * i)] = Wave_duration(params, bit ? params->oneUs : params->zeroUs);
+	}
+
+	delays[WAVE_NUM_TOGGLES - 1] = Wave_duration(params, params->bitLowUs);
+
+	//
+	//	Odd toggles release the line, a late rising edge moves the
+	//	time from the following HIGH level to the LOW level before.
+	//
+	for (i = 1; i < (WAVE_NUM_TOGGLES - 1); i += 2)
+	{
+		rise = Sim_fromMicros(params->riseUs);
+		if (rise >= delays[i + 1]) rise = delays[i + 1] - 1;
+
+		delays[i]     += rise;
+		delays[i + 1] -= rise;
+	}
+}
+
+//
+//	Play the next toggle, the line is pulled low on even toggles
+//	and released on odd ones.
+//
+static void Wave_step(UArg arg)
+{
+	Wave_Sensor* sensor = (Wave_Sensor*)arg;
+	Bool low = !(sensor->toggle % 2);
+
+	SimPin_drive(sensor->params.pin, low);
+	sensor->toggle++;
+
+	if (sensor->toggle < sensor->numToggles)
+	{
+		Sim_schedule(&sensor->event, Sim_now() + sensor->delays[sensor->toggle]);
+		return;
+	}
+
+	//
+	//	A cut short frame leaves the line free as well.
+	//
+	if (low) SimPin_drive(sensor->params.pin, FALSE);
+	sensor->busy = FALSE;
+}
+
+static void Wave_begin(Wave_Sensor* sensor)
+{
+	Wave_Frame frame;
+
+	memset(&frame, 0, sizeof(frame));
+	frame.pin      = sensor->params.pin;
+	frame.format   = sensor->params.format;
+	frame.numEdges = WAVE_NUM_EDGES;
+	sensor->params.frameFxn(&frame);
+	if (!frame.numEdges) return;
+
+	Wave_plan(&sensor->params, &frame, sensor->delays);
+
+	sensor->numToggles = (frame.numEdges >= WAVE_NUM_EDGES) ? WAVE_NUM_TOGGLES : frame.numEdges;
+	sensor->toggle = 0;
+	sensor->busy = TRUE;
+	Wave_stats.frames++;
+
+	Sim_schedule(&sensor->event, Sim_now() + sensor->delays[0]);
+}
+
+//
+//	The host released a line it pulled low, it rises riseUs late as
+//	every other rising edge. The sensor only sees the start pulse
+//	end once it did.
+//
+static void Wave_writeFxn(uint32_t written, uint32_t outputs)
+{
+	Wave_Sensor* sensor = NULL;
+	uint32_t bit = 0, held = 0;
+	uint8_t  i = 0;
+
+	for (i = 0; i < Wave_numSensors; i++)
+	{
+		sensor = &Wave_sensors[i];
+		bit    = (uint32_t)1 << sensor->params.pin;
+
+		if (!(written & outputs & bit) || (SimPin_getLines() & bit) || sensor->busy || sensor->holding ||
+		    !sensor->params.riseUs)
+		{
+			continue;
+		}
+
+		sensor->holding = TRUE;
+		held |= bit;
+		Sim_schedule(&sensor->holdEvent, Sim_now() + Sim_fromMicros(sensor->params.riseUs));
+	}
+
+	//
+	//	A port write releases its lines together, they are all held
+	//	before any of them could rise.
+	//
+	if (held) SimPin_drivePins(held, TRUE);
+}
+
+static void Wave_rise(UArg arg)
+{
+	Wave_Sensor* sensor = (Wave_Sensor*)arg;
+
+	sensor->holding = FALSE;
+	SimPin_drive(sensor->params.pin, FALSE);
+}
+
+//
+//	Watch the lines for the end of a long enough start pulse.
+//
+static void Wave_lineFxn(uint32_t changed, uint32_t lines)
+{
+	Wave_Sensor* sensor = NULL;
+	uint32_t bit = 0;
+	uint8_t  i = 0;
+
+	for (i = 0; i < Wave_numSensors; i++)
+	{
+		sensor = &Wave_sensors[i];
+		bit    = (uint32_t)1 << sensor->params.pin;
+
+		if (!(changed & bit) || sensor->busy) continue;
+
+		if (!(lines & bit))
+		{
+			sensor->fallTime = Sim_now();
+		}
+		else if ((Sim_now() - sensor->fallTime) >= Sim_fromMicros(sensor->params.startMinUs))
+		{
+			if (sensor->started && ((sensor->fallTime - sensor->startTime) < Sim_fromMicros(sensor->params.intervalMs * 1000)))
+			{
+				Wave_stats.early++;
+			}
+
+			if ((Sim_now() - sensor->fallTime) > Wave_stats.longestStart) Wave_stats.longestStart = Sim_now() - sensor->fallTime;
+
+			sensor->started   = TRUE;
+			sensor->startTime = sensor->fallTime;
+			Wave_begin(sensor);
+		}
+		else
+		{
+			Wave_stats.ignored++;
+		}
+	}
+}
+
+void Wave_Params_init(Wave_Params* params)
+{
+	params->pin            = PIN_UNASSIGNED;
+	params->format         = WAVE_FORMAT_DHT11;
+	params->frameFxn       = NULL;
+	//
+	//	The datasheet asks for 18 ms, parts answer to a bit less and a
+	//	pulse timed by a Clock can end up to one tick short.
+	//
+	params->intervalMs     = 0;
+	params->startMinUs     = 17500;
+	params->goUs           = 30;
+	params->responseLowUs  = 80;
+	params->responseHighUs = 80;
+	params->bitLowUs       = 50;
+	params->zeroUs         = 27;
+	params->oneUs          = 70;
+	params->jitterUs       = 0;
+	params->seed           = 1;
+	params->scalePercent   = 100;
+	params->riseUs         = 0;
+}
+
+void Wave_init(const Wave_Params* params)
+{
+	Wave_Sensor* sensor = NULL;
+
+	if (Wave_numSensors == WAVE_MAX_SENSORS)
+	{
+		Sim_fail("too many sensors");
+		return;
+	}
+
+	sensor = &Wave_sensors[Wave_numSensors];
+	sensor->params = *params;
+	Sim_Event_init(&sensor->event, Wave_step, (UArg)sensor, SIM_LEVEL_EXT);
+	Sim_Event_init(&sensor->holdEvent, Wave_rise, (UArg)sensor, SIM_LEVEL_EXT);
+
+	if (!Wave_numSensors++)
+	{
+		SimPin_watchLines(Wave_lineFxn);
+		SimPin_watchWrites(Wave_writeFxn);
+	}
+}
+
+const Wave_Stats* Wave_getStats(void)
+{
+	return &Wave_stats;
+}
+
+void Wave_setChecksum(Wave_Frame* frame)
+{
+	uint8_t i = 0;
+
+	frame->bytes[WAVE_NUM_BYTES - 1] = 0;
+	for (i = 0; i < (WAVE_NUM_BYTES - 1); i++) frame->bytes[WAVE_NUM_BYTES - 1] += frame->bytes[i];
+}
+
+void Wave_setValues(Wave_Frame* frame, uint16_t humidity, int16_t temperature)
+{
+	uint16_t magnitude = (temperature < 0) ? -temperature : temperature;
+	uint8_t  sign      = (temperature < 0) ? 0x80 : 0;
+
+	if (frame->format == WAVE_FORMAT_DHT11)
+	{
+		frame->bytes[0] = humidity / 10;
+		frame->bytes[1] = humidity % 10;
+		frame->bytes[2] = magnitude / 10;
+		frame->bytes[3] = (magnitude % 10) | sign;
+	}
+	else
+	{
+		frame->bytes[0] = humidity >> 8;
+		frame->bytes[1] = humidity & 0xFF;
+		frame->bytes[2] = (magnitude >> 8) | sign;
+		frame->bytes[3] = magnitude & 0xFF;
+	}
+
+	Wave_setChecksum(frame);
+}
+
+void Wave_render(Wave_Params* params, const Wave_Frame* frame, uint32_t start, uint32_t* edges)
+{
+	Sim_Time delays[WAVE_NUM_TOGGLES];
+	Sim_Time time = start;
+	uint8_t  i = 0;
+
+	Wave_plan(params, frame, delays);
+
+	for (i = 0; i < WAVE_NUM_EDGES; i++)
+	{
+		time += delays[i];
+		edges[i] = (uint32_t)time;
+	}
+}
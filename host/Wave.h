@@ -0,0 +1,139 @@
+#ifndef __WAVE_H__
+#define __WAVE_H__
+
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "Sim.h"
+
+//
+//	DHT11 sensor model. It watches the data line for the start
+//	pulse and answers with the response and a 40 bit frame, played
+//	onto the line as timed edges. Up to WAVE_MAX_SENSORS sensors,
+//	each on its own line.
+//
+#define WAVE_NUM_BYTES					5
+#define WAVE_NUM_EDGES					(3 + (WAVE_NUM_BYTES * 8 * 2))
+#define WAVE_MAX_SENSORS				8
+
+//
+//	How the bytes hold the values. DHT11: integral and decimal
+//	bytes, the sign in the top bit of the temperature decimal.
+//	DHT22/AM2302 and DHT21/AM2301: 16 bit tenths, the sign in the
+//	top bit of the temperature.
+//
+#define WAVE_FORMAT_DHT11				0
+#define WAVE_FORMAT_DHT22				1
+
+typedef struct Wave_Frame
+{
+	//
+	//	Line and value format of the sensor asked.
+	//
+	PIN_Id  pin;
+	uint8_t format;
+	uint8_t bytes[WAVE_NUM_BYTES];
+
+	//
+	//	Edges sent before the sensor goes quiet, WAVE_NUM_EDGES for
+	//	a complete frame, 0 to ignore the request.
+	//
+	uint8_t numEdges;
+} Wave_Frame;
+
+//
+//	Called for every start pulse to fill in the frame to send.
+//
+typedef void (*Wave_FrameFxn)(Wave_Frame* frame);
+
+typedef struct Wave_Params
+{
+	PIN_Id        pin;
+	uint8_t       format;
+	Wave_FrameFxn frameFxn;
+
+	//
+	//	Shortest time from one start pulse to the next the sensor
+	//	allows, 0 for any. Earlier ones are answered but counted.
+	//
+	uint32_t intervalMs;
+
+	//
+	//	Shortest start pulse the sensor answers to, and the timing
+	//	of the answer, in microseconds.
+	//
+	uint32_t startMinUs;
+	uint32_t goUs;
+	uint32_t responseLowUs;
+	uint32_t responseHighUs;
+	uint32_t bitLowUs;
+	uint32_t zeroUs;
+	uint32_t oneUs;
+
+	//
+	//	Every level lasts up to jitterUs more or less than nominal.
+	//
+	uint32_t jitterUs;
+	uint32_t seed;
+
+	//
+	//	Faults. Every level lasts scalePercent of nominal (a sensor
+	//	clock running slow or fast), and every rising edge reaches the
+	//	host riseUs late (a long cable against the pull-up), so each
+	//	LOW level grows and each HIGH level shrinks by that much. The
+	//	host's release of the start pulse rises as late.
+	//
+	uint32_t scalePercent;
+	uint32_t riseUs;
+} Wave_Params;
+
+typedef struct Wave_Stats
+{
+	uint32_t frames;
+	uint32_t ignored;
+	uint32_t early;
+
+	//
+	//	Longest start pulse answered, a host that holds the line past
+	//	its start clock keeps the device awake for nothing.
+	//
+	Sim_Time longestStart;
+} Wave_Stats;
+
+//
+//	Add a sensor, once per line. The stats count all of them.
+//
+void Wave_Params_init(Wave_Params* params);
+void Wave_init(const Wave_Params* params);
+
+const Wave_Stats* Wave_getStats(void);
+
+//
+//	Timestamps of the edges the host would capture for a frame,
+//	starting at the end of the start pulse, without playing it on
+//	the line. Jitter draws from params->seed.
+//
+void Wave_render(Wave_Params* params, const Wave_Frame* frame, uint32_t start, uint32_t* edges);
+
+//
+//	Fill in the checksum byte of a frame.
+//
+void Wave_setChecksum(Wave_Frame* frame);
+
+//
+//	Fill in a frame with values in tenths, in the format of the
+//	sensor asked, and its checksum.
+//
+void Wave_setValues(Wave_Frame* frame, uint16_t humidity, int16_t temperature);
+
+#endif
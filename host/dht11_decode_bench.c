@@ -0,0 +1,83 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+#include "DHT11Decode.h"
+#include "Sim.h"
+#include "Wave.h"
+
+//
+//	Frames decoded per second by the DHT11 frame decoder, over a
+//	set of pre-rendered frames with sensor jitter.
+//
+#define BENCH_NUM_FRAMES				1024
+
+static uint32_t Bench_edges[BENCH_NUM_FRAMES][DHT11_NUM_EDGES];
+
+static double Bench_seconds(const struct timespec* start, const struct timespec* end)
+{
+	return (end->tv_sec - start->tv_sec) + ((end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+int main(int argc, char* argv[])
+{
+	Wave_Params     params;
+	Wave_Frame      frame;
+	DHT11_Reading   reading;
+	struct timespec start, end;
+	uint32_t iterations = 10000000, seed = 1, i = 0, k = 0, failures = 0, sum = 0;
+	double   seconds = 0;
+	int      option = 0;
+
+	Wave_Params_init(&params);
+	params.jitterUs = 5;
+
+	while ((option = getopt(argc, argv, "n:s:j:")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': iterations      = strtoul(optarg, NULL, 0); break;
+			case 's': seed            = strtoul(optarg, NULL, 0); break;
+			case 'j': params.jitterUs = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n frames] [-s seed] [-j jitter us]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	params.seed = seed;
+
+	for (i = 0; i < BENCH_NUM_FRAMES; i++)
+	{
+		memset(&frame, 0, sizeof(frame));
+		for (k = 0; k < 4; k++) frame.bytes[k] = rand_r(&seed);
+		Wave_setChecksum(&frame);
+		Wave_render(&params, &frame, rand_r(&seed), Bench_edges[i]);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < iterations; i++)
+	{
+		failures += DHT11_decode(Bench_edges[i % BENCH_NUM_FRAMES], DHT11_NUM_EDGES, 0xFFFFFFFF,
+		                         Sim_fromMicros(DHT11_THRESHOLD), &reading) != DHT11_OK;
+		sum += reading.temperature;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = Bench_seconds(&start, &end);
+
+	printf("decoded %u frames in %.3f s: %.0f frames/s, %.1f ns/frame, %u failures (sum %u)\n",
+	       iterations, seconds, iterations / seconds, (seconds * 1e9) / iterations, failures, sum);
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
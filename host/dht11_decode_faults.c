@@ -0,0 +1,128 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+#include "DHT11Decode.h"
+#include "Sim.h"
+#include "Wave.h"
+
+//
+//	Fault injection for the DHT11 frame decoder: random frames are
+//	rendered with timing faults and decoded with both the fixed and
+//	the adaptive threshold, counting the frames each one loses.
+//
+#define FAULTS_MASK							0xFFFFFFFF
+#define FAULTS_FIXED						Sim_fromMicros(DHT11_THRESHOLD)
+
+typedef struct Faults_Scenario
+{
+	const char* name;
+	uint32_t    jitterUs;
+	uint32_t    scalePercent;
+	uint32_t    riseUs;
+} Faults_Scenario;
+
+static const Faults_Scenario Faults_scenarios[] =
+{
+	{ "nominal",          2, 100,  0 },
+	{ "jitter 12 us",    12, 100,  0 },
+	{ "jitter 20 us",    20, 100,  0 },
+	{ "cable 15 us",      4, 100, 15 },
+	{ "cable 28 us",      4, 100, 28 },
+	{ "clock 70 %",       4,  70,  0 },
+	{ "clock 130 %",      4, 130,  0 },
+	{ "combined",         8,  85, 12 },
+};
+
+#define FAULTS_NUM_SCENARIOS		(sizeof(Faults_scenarios) / sizeof(Faults_scenarios[0]))
+
+//
+//	A frame is lost when it fails to decode or decodes to other
+//	bytes than were sent.
+//
+static Bool Faults_lost(const uint32_t* edges, uint32_t threshold, const Wave_Frame* frame)
+{
+	DHT11_Reading reading;
+
+	if (DHT11_decode(edges, DHT11_NUM_EDGES, FAULTS_MASK, threshold, &reading) != DHT11_OK) return TRUE;
+
+	return memcmp(reading.bytes, frame->bytes, DHT11_NUM_BYTES) != 0;
+}
+
+int main(int argc, char* argv[])
+{
+	const Faults_Scenario* scenario = NULL;
+	Wave_Params params;
+	Wave_Frame  frame;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint32_t frames = 20000, seed = 1, i = 0, k = 0;
+	uint32_t fixed = 0, adaptive = 0, fixedTotal = 0, adaptiveTotal = 0;
+	Bool     failed = FALSE;
+	int option = 0;
+
+	while ((option = getopt(argc, argv, "n:s:")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': frames = strtoul(optarg, NULL, 0); break;
+			case 's': seed   = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "usage: %s [-n frames] [-s seed]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	printf("%-16s %12s %12s\n", "scenario", "fixed", "adaptive");
+
+	for (scenario = Faults_scenarios; scenario < (Faults_scenarios + FAULTS_NUM_SCENARIOS); scenario++)
+	{
+		Wave_Params_init(&params);
+		params.jitterUs     = scenario->jitterUs;
+		params.scalePercent = scenario->scalePercent;
+		params.riseUs       = scenario->riseUs;
+		params.seed         = seed;
+
+		fixed = adaptive = 0;
+
+		for (i = 0; i < frames; i++)
+		{
+			memset(&frame, 0, sizeof(frame));
+			for (k = 0; k < 4; k++) frame.bytes[k] = rand_r(&params.seed);
+			frame.numEdges = WAVE_NUM_EDGES;
+			Wave_setChecksum(&frame);
+
+			Wave_render(&params, &frame, rand_r(&params.seed), edges);
+
+			fixed    += Faults_lost(edges, FAULTS_FIXED, &frame);
+			adaptive += Faults_lost(edges, DHT11_THRESHOLD_AUTO, &frame);
+		}
+
+		printf("%-16s %11.2f%% %11.2f%%\n", scenario->name,
+		       (100.0 * fixed) / frames, (100.0 * adaptive) / frames);
+
+		//
+		//	The adaptive threshold may never lose more than the fixed one.
+		//
+		if (adaptive > fixed) failed = TRUE;
+
+		fixedTotal    += fixed;
+		adaptiveTotal += adaptive;
+	}
+
+	printf("%-16s %11.2f%% %11.2f%%\n", "total",
+	       (100.0 * fixedTotal) / (frames * FAULTS_NUM_SCENARIOS),
+	       (100.0 * adaptiveTotal) / (frames * FAULTS_NUM_SCENARIOS));
+
+	if (adaptiveTotal >= fixedTotal) failed = TRUE;
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,421 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+
+#include "DHT11Decode.h"
+#include "Sim.h"
+#include "Wave.h"
+
+//
+//	Regression and fuzz suite for the DHT11 frame decoder.
+//
+#define FUZZ_MASK_32						0xFFFFFFFF
+#define FUZZ_MASK_24						0x00FFFFFF
+#define FUZZ_THRESHOLD					Sim_fromMicros(DHT11_THRESHOLD)
+
+//
+//	Known frames: humidity, decimal, temperature, decimal.
+//
+static const uint8_t Fuzz_vectors[][4] =
+{
+	{ 0,   0, 0,   0 },
+	{ 40,  0, 23,  0 },
+	{ 95,  0, 50,  0 },
+	{ 255, 0, 255, 0 },
+	{ 0xAA, 0x55, 0xAA, 0x55 },
+	{ 1,   2, 3,   4 },
+};
+
+//
+//	Known values of the sensor family, in tenths, with the bytes
+//	that carry them.
+//
+typedef struct Fuzz_Values
+{
+	uint8_t  bytes[4];
+	uint16_t humidity;
+	int16_t  temperature;
+} Fuzz_Values;
+
+#if DHT11_SENSOR == DHT11_SENSOR_DHT11
+#define FUZZ_FORMAT							WAVE_FORMAT_DHT11
+
+static const Fuzz_Values Fuzz_values[] =
+{
+	{ { 40, 0, 23, 0 },    400,  230 },
+	{ { 55, 3, 21, 7 },    553,  217 },
+	{ { 30, 0, 0,  0x85 }, 300,  -5 },
+	{ { 90, 0, 20, 0x81 }, 900,  -201 },
+};
+#else
+#define FUZZ_FORMAT							WAVE_FORMAT_DHT22
+
+static const Fuzz_Values Fuzz_values[] =
+{
+	{ { 0x02, 0x8C, 0x01, 0x5F }, 652,  351 },
+	{ { 0x02, 0x8C, 0x80, 0x65 }, 652,  -101 },
+	{ { 0x03, 0xE8, 0x03, 0x20 }, 1000, 800 },
+	{ { 0x00, 0x00, 0x81, 0x90 }, 0,    -400 },
+};
+#endif
+
+static uint32_t Fuzz_checks;
+static uint32_t Fuzz_failures;
+static Bool     Fuzz_verbose;
+
+static void Fuzz_expect(Bool condition, const char* what, uint32_t detail)
+{
+	Fuzz_checks++;
+	if (condition) return;
+
+	Fuzz_failures++;
+	if (Fuzz_verbose || (Fuzz_failures <= 10)) printf("FAIL: %s (%u)\n", what, detail);
+}
+
+static void Fuzz_frame(Wave_Frame* frame, const uint8_t* data)
+{
+	memset(frame, 0, sizeof(Wave_Frame));
+	memcpy(frame->bytes, data, 4);
+	frame->numEdges = WAVE_NUM_EDGES;
+	Wave_setChecksum(frame);
+}
+
+static Bool Fuzz_same(const DHT11_Reading* reading, const Wave_Frame* frame)
+{
+	return !memcmp(reading->bytes, frame->bytes, DHT11_NUM_BYTES) &&
+	       (reading->humidity == DHT11_HUMIDITY(frame->bytes)) && (reading->temperature == DHT11_TEMPERATURE(frame->bytes));
+}
+
+//
+//	Every known frame decodes, from any start time, across the
+//	32 bit wrap and across the wrap of a 24 bit capture timer.
+//
+static void Fuzz_regression(void)
+{
+	static const uint32_t starts[] = { 0, 0x12345678, 0xFFFFFF00, 0xFFFFFFFF };
+	Wave_Params   params;
+	Wave_Frame    frame;
+	DHT11_Reading reading;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint8_t  i = 0, j = 0, k = 0;
+
+	Wave_Params_init(&params);
+
+	for (i = 0; i < (sizeof(Fuzz_vectors) / sizeof(Fuzz_vectors[0])); i++)
+	{
+		Fuzz_frame(&frame, Fuzz_vectors[i]);
+
+		for (j = 0; j < (sizeof(starts) / sizeof(starts[0])); j++)
+		{
+			Wave_render(&params, &frame, starts[j], edges);
+			Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, FUZZ_THRESHOLD, &reading) == DHT11_OK,
+			            "vector decodes", i);
+			Fuzz_expect(Fuzz_same(&reading, &frame), "vector matches", i);
+
+			Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, DHT11_THRESHOLD_AUTO, &reading) == DHT11_OK,
+			            "adaptive vector decodes", i);
+			Fuzz_expect(Fuzz_same(&reading, &frame), "adaptive vector matches", i);
+
+			for (k = 0; k < DHT11_NUM_EDGES; k++) edges[k] &= FUZZ_MASK_24;
+			Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_24, FUZZ_THRESHOLD, &reading) == DHT11_OK,
+			            "24 bit vector decodes", i);
+			Fuzz_expect(Fuzz_same(&reading, &frame), "24 bit vector matches", i);
+		}
+	}
+}
+
+//
+//	The known values of the family decode from their bytes, and the
+//	sensor model encodes them into the same bytes.
+//
+static void Fuzz_decimal(void)
+{
+	Wave_Params   params;
+	Wave_Frame    frame, encoded;
+	DHT11_Reading reading;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint8_t  i = 0;
+
+	Wave_Params_init(&params);
+
+	for (i = 0; i < (sizeof(Fuzz_values) / sizeof(Fuzz_values[0])); i++)
+	{
+		Fuzz_frame(&frame, Fuzz_values[i].bytes);
+		Wave_render(&params, &frame, 0, edges);
+
+		Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, DHT11_THRESHOLD_AUTO, &reading) == DHT11_OK,
+		            "values decode", i);
+		Fuzz_expect((reading.humidity == Fuzz_values[i].humidity) && (reading.temperature == Fuzz_values[i].temperature),
+		            "values match", i);
+
+		memset(&encoded, 0, sizeof(encoded));
+		encoded.format = FUZZ_FORMAT;
+		Wave_setValues(&encoded, Fuzz_values[i].humidity, Fuzz_values[i].temperature);
+		Fuzz_expect(!memcmp(encoded.bytes, frame.bytes, DHT11_NUM_BYTES), "values encode", i);
+	}
+}
+
+//
+//	A width equal to the threshold is a "0", one tick more a "1".
+//
+static void Fuzz_threshold(void)
+{
+	Wave_Frame    frame;
+	DHT11_Reading reading;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint32_t time = 0;
+	uint8_t  i = 0, bit = 0;
+
+	Fuzz_frame(&frame, Fuzz_vectors[4]);
+
+	edges[0] = time += Sim_fromMicros(30);
+	edges[1] = time += Sim_fromMicros(80);
+	edges[2] = time += Sim_fromMicros(80);
+
+	for (i = 0; i < (DHT11_NUM_BYTES * 8); i++)
+	{
+		bit = (frame.bytes[i / 8] >> (7 - (i % 8))) & 1;
+
+		edges[3 + (2 * i)] = time += Sim_fromMicros(50);
+		edges[4 + (2 * i)] = time += FUZZ_THRESHOLD + bit;
+	}
+
+	Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, FUZZ_THRESHOLD, &reading) == DHT11_OK,
+	            "threshold frame decodes", 0);
+	Fuzz_expect(Fuzz_same(&reading, &frame), "threshold frame matches", 0);
+}
+
+//
+//	Cut short frames time out in the right phase, and leave the
+//	reading untouched.
+//
+static void Fuzz_truncated(void)
+{
+	Wave_Params   params;
+	Wave_Frame    frame;
+	DHT11_Reading reading, sentinel;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint8_t  numEdges = 0, phase = 0;
+
+	Wave_Params_init(&params);
+	Fuzz_frame(&frame, Fuzz_vectors[1]);
+	Wave_render(&params, &frame, 0, edges);
+	memset(&sentinel, 0xA5, sizeof(sentinel));
+
+	for (numEdges = 0; numEdges < DHT11_NUM_EDGES; numEdges++)
+	{
+		reading = sentinel;
+		Fuzz_expect(DHT11_decode(edges, numEdges, FUZZ_MASK_32, FUZZ_THRESHOLD, &reading) == DHT11_ERROR_TIMEOUT,
+		            "truncated frame times out", numEdges);
+		Fuzz_expect(!memcmp(&reading, &sentinel, sizeof(reading)), "truncated frame leaves the reading", numEdges);
+
+		phase = (numEdges < 3) ? DHT11_PHASE_RESPONSE : ((numEdges % 2) ? DHT11_PHASE_BIT_LOW : DHT11_PHASE_BIT_HIGH);
+		Fuzz_expect(DHT11_edgePhase(numEdges) == phase, "timeout phase", numEdges);
+	}
+}
+
+//
+//	Any single flipped bit breaks the checksum.
+//
+static void Fuzz_checksum(void)
+{
+	Wave_Params   params;
+	Wave_Frame    frame;
+	DHT11_Reading reading;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint8_t  i = 0;
+
+	Wave_Params_init(&params);
+
+	for (i = 0; i < (DHT11_NUM_BYTES * 8); i++)
+	{
+		Fuzz_frame(&frame, Fuzz_vectors[1]);
+		frame.bytes[i / 8] ^= 1 << (7 - (i % 8));
+
+		Wave_render(&params, &frame, 0, edges);
+		Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, FUZZ_THRESHOLD, &reading) == DHT11_ERROR_CHECKSUM,
+		            "flipped bit fails the checksum", i);
+	}
+}
+
+//
+//	Random frames within the sensor's timing spread must decode.
+//	Random timestamps must never crash the decoder, and whatever it
+//	accepts has to carry a valid checksum.
+//
+static void Fuzz_random(uint32_t iterations, uint32_t seed)
+{
+	Wave_Params   params;
+	Wave_Frame    frame;
+	DHT11_Reading reading, sentinel;
+	uint32_t edges[DHT11_NUM_EDGES];
+	uint8_t  data[4], numEdges = 0, result = 0, checkSum = 0;
+	uint32_t i = 0, k = 0;
+
+	Wave_Params_init(&params);
+	params.jitterUs = 8;
+	params.seed     = seed;
+	memset(&sentinel, 0xA5, sizeof(sentinel));
+
+	for (i = 0; i < iterations; i++)
+	{
+		for (k = 0; k < 4; k++) data[k] = rand_r(&seed);
+
+		Fuzz_frame(&frame, data);
+		Wave_render(&params, &frame, rand_r(&seed), edges);
+		Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, FUZZ_THRESHOLD, &reading) == DHT11_OK,
+		            "random frame decodes", i);
+		Fuzz_expect(Fuzz_same(&reading, &frame), "random frame matches", i);
+		Fuzz_expect(DHT11_decode(edges, DHT11_NUM_EDGES, FUZZ_MASK_32, DHT11_THRESHOLD_AUTO, &reading) == DHT11_OK,
+		            "adaptive random frame decodes", i);
+		Fuzz_expect(Fuzz_same(&reading, &frame), "adaptive random frame matches", i);
+
+		numEdges = rand_r(&seed) % (DHT11_NUM_EDGES + 8);
+		for (k = 0; k < DHT11_NUM_EDGES; k++) edges[k] = rand_r(&seed) ^ ((uint32_t)rand_r(&seed) << 16);
+
+		reading = sentinel;
+		result  = DHT11_decode(edges, numEdges, FUZZ_MASK_32, (i % 2) ? DHT11_THRESHOLD_AUTO : FUZZ_THRESHOLD, &reading);
+		Fuzz_expect(result <= DHT11_ERROR_CHECKSUM, "garbage result code", i);
+
+		if (result == DHT11_OK)
+		{
+			for (k = 0, checkSum = 0; k < (DHT11_NUM_BYTES - 1); k++) checkSum += reading.bytes[k];
+			Fuzz_expect(checkSum == reading.bytes[DHT11_NUM_BYTES - 1], "accepted garbage has a valid checksum", i);
+		}
+		else
+		{
+			Fuzz_expect(!memcmp(&reading, &sentinel, sizeof(reading)), "rejected garbage leaves the reading", i);
+		}
+	}
+}
+
+//
+//	Sensors sampled together from one port: up to FUZZ_MAX_LANES
+//	frames with their own timing on random port bits, sampled every
+//	1 to 3 us with now and then a 5 us gap as a preempting Hwi would
+//	leave. Every lane decodes to its frame, a lane cut short times
+//	out with the edges it sent.
+//
+#define FUZZ_MAX_LANES					8
+#define FUZZ_SAMPLE_MIN					Sim_fromMicros(1)
+#define FUZZ_SAMPLE_SPREAD			Sim_fromMicros(2)
+#define FUZZ_GAP								Sim_fromMicros(5)
+#define FUZZ_LANES_US						8000
+
+static void Fuzz_lanes(uint32_t iterations, uint32_t seed)
+{
+	Wave_Params   params;
+	Wave_Frame    frames[FUZZ_MAX_LANES];
+	DHT11_Reading reading;
+	DHT11_Lanes   lanes;
+	uint32_t edges[FUZZ_MAX_LANES][DHT11_NUM_EDGES + 1];
+	uint8_t  pins[FUZZ_MAX_LANES], numEdges[FUZZ_MAX_LANES], sent[FUZZ_MAX_LANES];
+	uint8_t  data[4], numLanes = 0, edgesSeen = 0, result = 0, lane = 0;
+	uint32_t mask = 0, start = 0, time = 0, word = 0, done = 0, i = 0, k = 0;
+
+	Wave_Params_init(&params);
+	params.jitterUs = 8;
+	params.seed     = seed;
+
+	for (i = 0; i < iterations; i++)
+	{
+		numLanes = 1 + (rand_r(&seed) % FUZZ_MAX_LANES);
+		start    = rand_r(&seed) ^ ((uint32_t)rand_r(&seed) << 16);
+		mask     = 0;
+
+		for (lane = 0; lane < numLanes; lane++)
+		{
+			do pins[lane] = rand_r(&seed) % 32; while (mask & (1u << pins[lane]));
+			mask |= 1u << pins[lane];
+
+			for (k = 0; k < 4; k++) data[k] = rand_r(&seed);
+			Fuzz_frame(&frames[lane], data);
+			Wave_render(&params, &frames[lane], start, edges[lane]);
+
+			//
+			//	The sensor releases the line a LOW gap after the last bit.
+			//
+			edges[lane][DHT11_NUM_EDGES] = edges[lane][DHT11_NUM_EDGES - 1] + Sim_fromMicros(50);
+			sent[lane] = DHT11_NUM_EDGES + 1;
+
+			if (!(rand_r(&seed) % 4)) sent[lane] = rand_r(&seed) % DHT11_NUM_EDGES;
+		}
+
+		DHT11_lanesInit(&lanes, mask, start, FUZZ_THRESHOLD);
+		memset(numEdges, 0, sizeof(numEdges));
+		done = 0;
+
+		for (time = start; (time - start) < Sim_fromMicros(FUZZ_LANES_US) && (done != mask); )
+		{
+			time += FUZZ_SAMPLE_MIN + (rand_r(&seed) % FUZZ_SAMPLE_SPREAD);
+			if (!(rand_r(&seed) % 500)) time += FUZZ_GAP;
+
+			//
+			//	A lane is low after an odd number of edges.
+			//
+			for (lane = 0, word = 0; lane < numLanes; lane++)
+			{
+				while ((numEdges[lane] < sent[lane]) && ((int32_t)(time - edges[lane][numEdges[lane]]) >= 0)) numEdges[lane]++;
+				if (!(numEdges[lane] % 2)) word |= 1u << pins[lane];
+			}
+
+			done = DHT11_lanesStep(&lanes, word, time);
+		}
+
+		for (lane = 0; lane < numLanes; lane++)
+		{
+			result = DHT11_lanesDecode(&lanes, pins[lane], &edgesSeen, &reading);
+
+			if (sent[lane] > DHT11_NUM_EDGES)
+			{
+				Fuzz_expect(result == DHT11_OK, "lane decodes", i);
+				Fuzz_expect((result != DHT11_OK) || Fuzz_same(&reading, &frames[lane]), "lane matches", i);
+			}
+			else
+			{
+				Fuzz_expect(result == DHT11_ERROR_TIMEOUT, "cut short lane times out", i);
+				Fuzz_expect(edgesSeen == sent[lane], "cut short lane edges", sent[lane]);
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t iterations = 100000, seed = 1;
+	int option = 0;
+
+	while ((option = getopt(argc, argv, "n:s:v")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': iterations   = strtoul(optarg, NULL, 0); break;
+			case 's': seed         = strtoul(optarg, NULL, 0); break;
+			case 'v': Fuzz_verbose = TRUE;                     break;
+			default:
+				fprintf(stderr, "usage: %s [-n iterations] [-s seed] [-v]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	Fuzz_regression();
+	Fuzz_decimal();
+	Fuzz_threshold();
+	Fuzz_truncated();
+	Fuzz_checksum();
+	Fuzz_random(iterations, seed);
+	Fuzz_lanes(iterations / 100, seed);
+
+	printf("checks: %u, failures: %u\n", Fuzz_checks, Fuzz_failures);
+
+	return Fuzz_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,427 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/knl/Clock.h>
+
+#include "DHT11.h"
+#include "Display.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+#include "Sim.h"
+#include "SimPower.h"
+#include "SimUart.h"
+#include "Wave.h"
+#include "Recorder.h"
+#include "Segments.h"
+
+//
+//	Board wiring of the display, as in dht11_display7seg/main.c, the segment
+//	pins come from its Segments.h.
+//
+#define DIGIT_UNITS							PIN_ID(27)
+#define DIGIT_TENS							PIN_ID(26)
+
+//
+//	Each digit is refreshed every HARNESS_NUM_DIGITS dwells, a
+//	sensor read may delay that by less than one dwell.
+//
+#define HARNESS_NUM_DIGITS			2
+#define HARNESS_MAX_GAP_US			((HARNESS_NUM_DIGITS + 1) * Display_getDwell())
+
+//
+//	Display power modes of dht11_display7seg/main.c.
+//
+#define POWER_MODE_ON						0
+#define POWER_MODE_BLINK				1
+#define POWER_MODE_OFF					2
+
+static const char* const Harness_powerModes[] = { "on", "blink", "off" };
+
+//
+//	The firmware's main(), renamed by the build, and its power mode.
+//
+int App_main(void);
+extern uint8_t powerMode;
+
+//
+//	The sensor model answers in the firmware's sensor family and
+//	counts the requests sooner than its sampling interval. The
+//	temperatures, in tenths, stay within what two digits show as a
+//	number, down to "-9".
+//
+#if DHT11_SENSOR == DHT11_SENSOR_DHT11
+#define HARNESS_FORMAT					WAVE_FORMAT_DHT11
+#define HARNESS_INTERVAL_MS			1000
+#define HARNESS_START_MIN_US		17500
+#else
+#define HARNESS_FORMAT					WAVE_FORMAT_DHT22
+#define HARNESS_INTERVAL_MS			2000
+#define HARNESS_START_MIN_US		800
+#endif
+
+#define HARNESS_TEMPERATURE_MIN	-94
+#define HARNESS_TEMPERATURE_MAX	500
+
+//
+//	A start pulse lasts DHT11_START_US, the Clock ending it may
+//	expire up to a tick late and runs a tick later than asked.
+//
+#define HARNESS_MAX_START_US		(DHT11_START_US + (2 * Clock_tickPeriod))
+
+static uint32_t Harness_numFrames = 1000;
+static Bool     Harness_verbose;
+static uint32_t Harness_seed = 1;
+
+static uint32_t Harness_sent;
+static uint32_t Harness_shown;
+static uint32_t Harness_wrong;
+static int16_t  Harness_temperature;
+
+//
+//	Faults (-e): a frame is cut short or gets a bit flipped with the
+//	given percentage. The driver retries it while the display keeps
+//	the last good frame, and shows an error once it gave up.
+//
+static uint32_t Harness_errorPercent;
+static uint32_t Harness_faultSeed;
+static uint32_t Harness_cutShort;
+static uint32_t Harness_flipped;
+static uint32_t Harness_failing;
+static uint32_t Harness_gaveUp;
+static Bool     Harness_showsError;
+
+//
+//	Driver counters when the last request came.
+//
+static DHT11_Stats Harness_stats;
+
+//
+//	Called by the sensor model at every start pulse. By then the
+//	display has to show the temperature of the last good frame, or
+//	have shown it last when it blinks. Dark, it shows nothing.
+//
+static void Harness_frame(Wave_Frame* frame)
+{
+	int32_t value    = Recorder_getValue();
+	int32_t expected = (Harness_temperature + ((Harness_temperature < 0) ? -5 : 5)) / 10;
+	int16_t temperature = 0;
+
+	//
+	//	A transaction that failed every retry shows an error until a
+	//	good frame comes.
+	//
+	if (Harness_failing > DHT11_RETRIES)
+	{
+		Harness_failing    = 0;
+		Harness_showsError = TRUE;
+		Harness_gaveUp++;
+	}
+
+	if (Harness_sent && (powerMode != POWER_MODE_OFF) && !Harness_showsError)
+	{
+		if (value == expected)
+		{
+			Harness_shown++;
+		}
+		else
+		{
+			Harness_wrong++;
+			if (Harness_verbose) printf("frame %u: sent %d, display shows %d\n", Harness_sent, Harness_temperature, value);
+		}
+	}
+
+	if (Harness_sent == Harness_numFrames)
+	{
+		frame->numEdges = 0;
+		DHT11_getStats(&Harness_stats);
+		Sim_stop();
+		return;
+	}
+
+	temperature = HARNESS_TEMPERATURE_MIN + (rand_r(&Harness_seed) % (HARNESS_TEMPERATURE_MAX - HARNESS_TEMPERATURE_MIN + 1));
+
+	Wave_setValues(frame, 200 + (rand_r(&Harness_seed) % 701), temperature);
+
+	if (Harness_errorPercent && ((rand_r(&Harness_faultSeed) % 100) < Harness_errorPercent))
+	{
+		if (rand_r(&Harness_faultSeed) & 1)
+		{
+			frame->numEdges = 1 + (rand_r(&Harness_faultSeed) % (WAVE_NUM_EDGES - 1));
+			Harness_cutShort++;
+		}
+		else
+		{
+			frame->bytes[rand_r(&Harness_faultSeed) % (WAVE_NUM_BYTES - 1)] ^= 1 << (rand_r(&Harness_faultSeed) % 8);
+			Harness_flipped++;
+		}
+
+		Harness_failing++;
+	}
+	else
+	{
+		Harness_temperature = temperature;
+		Harness_failing     = 0;
+		Harness_showsError  = FALSE;
+	}
+
+	Harness_sent++;
+}
+
+//
+//	The driver received every frame sent, counted it the way it was
+//	sent, and retried every failure but the ones it gave up on.
+//
+static Bool Harness_checkCounters(void)
+{
+	const DHT11_Stats* stats = &Harness_stats;
+	uint32_t faults = Harness_cutShort + Harness_flipped;
+
+	if (Harness_errorPercent) printf("faults: %u cut short, %u bit flipped, %u given up\n", Harness_cutShort, Harness_flipped, Harness_gaveUp);
+
+	if ((stats->reads != (Harness_sent - faults)) || (stats->checksums != Harness_flipped) ||
+	    ((stats->timeouts[DHT11_PHASE_RESPONSE] + stats->timeouts[DHT11_PHASE_BIT_LOW] + stats->timeouts[DHT11_PHASE_BIT_HIGH]) != Harness_cutShort) ||
+	    (stats->retries != (faults - Harness_gaveUp)))
+	{
+		printf("FAIL: driver counted %u reads, %u retries, %u checksum errors, %u/%u/%u timeouts\n", stats->reads, stats->retries,
+		       stats->checksums, stats->timeouts[DHT11_PHASE_RESPONSE], stats->timeouts[DHT11_PHASE_BIT_LOW],
+		       stats->timeouts[DHT11_PHASE_BIT_HIGH]);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+//
+//	Last CPU load report the firmware sent over the UART, and the
+//	last line of refresh statistics that follows it.
+//
+static char Harness_load[256];
+static char Harness_refresh[256];
+
+static void Harness_uart(const char* line)
+{
+	if (Harness_verbose) printf("uart: %s\n", line);
+
+	if (!strncmp(line, "display:", strlen("display:")))
+	{
+		strncpy(Harness_refresh, line, sizeof(Harness_refresh) - 1);
+	}
+	else if (!strncmp(line, "load", strlen("load")))
+	{
+		strncpy(Harness_load, line, sizeof(Harness_load) - 1);
+	}
+}
+
+//
+//	The firmware's handlers take simulated time for their pin, timer
+//	and kernel calls, the last report must show a load, and well
+//	under HARNESS_MAX_LOAD (thousandths of a percent): a frame
+//	busy-waited every few seconds is the most they do.
+//
+#define HARNESS_MAX_LOAD				1000
+
+static Bool Harness_checkLoad(void)
+{
+	unsigned int whole = 0, thousandths = 0, load = 0;
+
+	if (!CPULOAD) return TRUE;
+
+	if (sscanf(Harness_load, "load %u.%u%%", &whole, &thousandths) != 2)
+	{
+		printf("FAIL: no CPU load report\n");
+		return FALSE;
+	}
+
+	load = (whole * 1000) + thousandths;
+	if (!load || (load > HARNESS_MAX_LOAD))
+	{
+		printf("FAIL: CPU load %u.%03u%% outside 0.001%% to %u.%03u%%\n", whole, thousandths,
+		       HARNESS_MAX_LOAD / 1000, HARNESS_MAX_LOAD % 1000);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+//
+//	The timer refresh pays the Hwi entry on every refresh and none
+//	waits much longer, the firmware's Hwi_disable() sections are
+//	short. Jitter can't exceed the spread of the latency.
+//
+#define HARNESS_MIN_LATENCY_NS	((SIM_COST_HWI_ENTRY * 1000) / SIM_TICKS_PER_US)
+#define HARNESS_MAX_LATENCY_NS	20000
+
+static Bool Harness_checkLatency(const Display_Stats* stats)
+{
+	unsigned int reported[5] = { 0 };
+	int expected = (DISPLAY_MODE == DISPLAY_MODE_TIMER) ? 5 : 1;
+	Bool ok = TRUE;
+
+	if ((DISPLAY_MODE == DISPLAY_MODE_TIMER) &&
+	    ((stats->minLatencyNs < HARNESS_MIN_LATENCY_NS) || (stats->maxLatencyNs > HARNESS_MAX_LATENCY_NS) ||
+	     (stats->meanLatencyNs < stats->minLatencyNs) || (stats->meanLatencyNs > stats->maxLatencyNs) ||
+	     (stats->maxJitterNs > (stats->maxLatencyNs - stats->minLatencyNs))))
+	{
+		printf("FAIL: refresh latency outside %u to %u ns\n", HARNESS_MIN_LATENCY_NS, HARNESS_MAX_LATENCY_NS);
+		ok = FALSE;
+	}
+
+	if (CPULOAD && (sscanf(Harness_refresh, "display: refreshes %u, latency min %u ns, mean %u ns, max %u ns, jitter %u ns",
+	                       &reported[0], &reported[1], &reported[2], &reported[3], &reported[4]) != expected))
+	{
+		printf("FAIL: no display refresh report\n");
+		ok = FALSE;
+	}
+	else if (CPULOAD && (DISPLAY_MODE == DISPLAY_MODE_TIMER) &&
+	         ((reported[1] < HARNESS_MIN_LATENCY_NS) || (reported[3] > HARNESS_MAX_LATENCY_NS)))
+	{
+		printf("FAIL: reported refresh latency outside %u to %u ns\n", HARNESS_MIN_LATENCY_NS, HARNESS_MAX_LATENCY_NS);
+		ok = FALSE;
+	}
+
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	Wave_Params     waveParams;
+	Recorder_Params recorderParams;
+	const Recorder_Stats* stats = NULL;
+	const SimPower_Stats* power = NULL;
+	uint32_t displayUa = 0;
+	Sim_Time elapsed = 0;
+	Bool     lit = FALSE;
+	Display_Stats displayStats;
+	struct timespec start, end;
+	double seconds = 0;
+	Bool   jittered = FALSE;
+	Bool   counted = TRUE;
+	Bool   timed = TRUE;
+	Bool   loaded = TRUE;
+	int    option = 0;
+	uint8_t i = 0;
+
+	Wave_Params_init(&waveParams);
+	waveParams.format     = HARNESS_FORMAT;
+	waveParams.intervalMs = HARNESS_INTERVAL_MS;
+	waveParams.startMinUs = HARNESS_START_MIN_US;
+
+	while ((option = getopt(argc, argv, "n:s:j:e:p:v")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': Harness_numFrames    = strtoul(optarg, NULL, 0); break;
+			case 's': Harness_seed         = strtoul(optarg, NULL, 0); break;
+			case 'j': waveParams.jitterUs  = strtoul(optarg, NULL, 0); break;
+			case 'e': Harness_errorPercent = strtoul(optarg, NULL, 0); break;
+			case 'v': Harness_verbose      = TRUE;                     break;
+			case 'p':
+				for (powerMode = 0; powerMode <= POWER_MODE_OFF; powerMode++)
+				{
+					if (!strcmp(optarg, Harness_powerModes[powerMode])) break;
+				}
+				if (powerMode <= POWER_MODE_OFF) break;
+				/* fall through */
+			default:
+				fprintf(stderr, "usage: %s [-n frames] [-s seed] [-j jitter us] [-e error %%] [-p on|blink|off] [-v]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	waveParams.pin      = DHT11;
+	waveParams.frameFxn = Harness_frame;
+	waveParams.seed     = Harness_seed;
+	Wave_init(&waveParams);
+
+	Harness_faultSeed = Harness_seed;
+
+	Recorder_Params_init(&recorderParams);
+	recorderParams.segmentPins[0] = SEGMENT_A;
+	recorderParams.segmentPins[1] = SEGMENT_B;
+	recorderParams.segmentPins[2] = SEGMENT_C;
+	recorderParams.segmentPins[3] = SEGMENT_D;
+	recorderParams.segmentPins[4] = SEGMENT_E;
+	recorderParams.segmentPins[5] = SEGMENT_F;
+	recorderParams.segmentPins[6] = SEGMENT_G;
+	recorderParams.digitPins[0]   = DIGIT_TENS;
+	recorderParams.digitPins[1]   = DIGIT_UNITS;
+	recorderParams.numDigits      = HARNESS_NUM_DIGITS;
+	Recorder_init(&recorderParams);
+
+	//
+	//	The .cfg's Idle hook, and the UART the load reports come out of.
+	//	A profiling build asks for a dump while the first report goes
+	//	out, the two share the UART.
+	//
+	Sim_addIdleFunc(CpuLoad_idle);
+	SimUart_watch(Harness_uart);
+	if (PROFILE) SimUart_receive(Sim_fromMicros((CPULOAD_REPORT_MS + 1) * 1000), 'd');
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	App_main();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+	stats = Recorder_getStats();
+	power = SimPower_getStats();
+	elapsed = Sim_now();
+	displayUa = elapsed ? (uint32_t)((stats->segmentTime * DISPLAY_SEGMENT_CURRENT_UA) / elapsed) : 0;
+
+	printf("frames: %u, shown: %u, wrong: %u\n", Harness_sent, Harness_shown, Harness_wrong);
+	printf("display: %u writes, %u glitches, worst refresh gap tens %llu us, units %llu us\n",
+	       stats->writes, stats->glitches,
+	       (unsigned long long)Sim_toMicros(stats->maxGap[0]), (unsigned long long)Sim_toMicros(stats->maxGap[1]));
+	Display_getStats(&displayStats);
+	printf("refresh: %u, latency min %u ns, mean %u ns, max %u ns, jitter %u ns\n",
+	       displayStats.refreshes, displayStats.minLatencyNs, displayStats.meanLatencyNs,
+	       displayStats.maxLatencyNs, displayStats.maxJitterNs);
+	printf("power %s: active %.2f%%, idle %.2f%%, standby %.2f%%, MCU %u uA, display %u uA, total %u uA\n",
+	       Harness_powerModes[powerMode], (100.0 * power->active) / elapsed, (100.0 * power->idle) / elapsed,
+	       (100.0 * power->standby) / elapsed, SimPower_getCurrent(), displayUa, SimPower_getCurrent() + displayUa);
+	if (Harness_load[0]) printf("uart: %s\n", Harness_load);
+	if (Harness_refresh[0]) printf("uart: %s\n", Harness_refresh);
+	printf("simulated %.1f s in %.3f s, %.0f frames/s\n",
+	       Sim_toMicros(Sim_now()) / 1e6, seconds, Harness_sent / seconds);
+
+	//
+	//	What a byte received on the UART gets in a profiling build.
+	//
+	SimUart_watch(NULL);
+	Profile_dump();
+
+	//
+	//	A blinking display is dark between readings, the refresh gap
+	//	only holds while it stays on.
+	//
+	for (i = 0; i < HARNESS_NUM_DIGITS; i++)
+	{
+		if ((powerMode == POWER_MODE_ON) && (Sim_toMicros(stats->maxGap[i]) >= HARNESS_MAX_GAP_US)) jittered = TRUE;
+		if ((powerMode == POWER_MODE_OFF) && stats->refreshes[i]) lit = TRUE;
+	}
+
+	if (jittered) printf("FAIL: display refresh held for a dwell or more\n");
+	if (stats->glitches) printf("FAIL: torn display frames\n");
+	if (lit) printf("FAIL: display lit while off\n");
+	if (!Harness_checkLoad()) loaded = FALSE;
+	if (Wave_getStats()->early) printf("FAIL: the sensor was asked too early\n");
+	if (Sim_toMicros(Wave_getStats()->longestStart) > HARNESS_MAX_START_US) printf("FAIL: start pulse held past its clock\n");
+	if (!Harness_checkCounters()) counted = FALSE;
+	if (!Harness_checkLatency(&displayStats)) timed = FALSE;
+
+	return (Sim_failed() || Harness_wrong || jittered || lit || stats->glitches || (Harness_sent != Harness_numFrames) ||
+	        !loaded || Wave_getStats()->early || !counted || !timed ||
+	        (Sim_toMicros(Wave_getStats()->longestStart) > HARNESS_MAX_START_US)) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,535 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	BIOS Header files.
+//
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+
+#include "DHT11.h"
+#include "DHT11Multi.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+#include "Sim.h"
+#include "SimPower.h"
+#include "SimUart.h"
+#include "Wave.h"
+
+//
+//	The firmware's main(), renamed by the build.
+//
+int App_main(void);
+
+//
+//	Sensors on the port, DHT11_MULTI reads several at once.
+//
+#if DHT11_MULTI
+#define HARNESS_NUM_SENSORS			DHT11_MULTI_NUM_SENSORS
+
+static const PIN_Id Harness_pins[HARNESS_NUM_SENSORS] = { DHT11_MULTI_PINS };
+#else
+#define HARNESS_NUM_SENSORS			1
+
+static const PIN_Id Harness_pins[HARNESS_NUM_SENSORS] = { DHT11 };
+#endif
+
+//
+//	The sensor model answers in the firmware's sensor family, with
+//	values across the family's range, in tenths, and counts the
+//	requests sooner than the family's sampling interval.
+//
+#if DHT11_SENSOR == DHT11_SENSOR_DHT11
+#define HARNESS_FORMAT					WAVE_FORMAT_DHT11
+#define HARNESS_INTERVAL_MS			1000
+#define HARNESS_START_MIN_US		17500
+#define HARNESS_HUMIDITY_MIN		200
+#define HARNESS_HUMIDITY_MAX		900
+#define HARNESS_TEMPERATURE_MIN	-200
+#define HARNESS_TEMPERATURE_MAX	600
+#else
+#define HARNESS_FORMAT					WAVE_FORMAT_DHT22
+#define HARNESS_INTERVAL_MS			2000
+#define HARNESS_START_MIN_US		800
+#define HARNESS_HUMIDITY_MIN		0
+#define HARNESS_HUMIDITY_MAX		1000
+#define HARNESS_TEMPERATURE_MIN	-400
+#define HARNESS_TEMPERATURE_MAX	800
+#endif
+
+//
+//	A start pulse lasts DHT11_START_US, the Clock ending it may
+//	expire up to a tick late and runs a tick later than asked.
+//
+#define HARNESS_MAX_START_US		(DHT11_START_US + (2 * Clock_tickPeriod))
+
+//
+//	Longest the driver may hold the Swis off, far less than a frame.
+//
+#define HARNESS_MAX_SWI_MASK_US	100
+
+static uint32_t Harness_numFrames = 1000;
+static Bool     Harness_verbose;
+static uint32_t Harness_seed = 1;
+
+static uint32_t Harness_requests;
+static uint32_t Harness_sent;
+static uint32_t Harness_read;
+static uint32_t Harness_wrong;
+static uint32_t Harness_timeouts;
+static uint32_t Harness_checksums;
+static int16_t  Harness_temperature[HARNESS_NUM_SENSORS];
+static uint16_t Harness_humidity[HARNESS_NUM_SENSORS];
+static Bool     Harness_done;
+
+//
+//	Sensors whose good frame is read but not printed yet. A stop
+//	during DHT11_MULTI's retries leaves the frames of the others
+//	read and counted, the line printed with the retried ones never
+//	comes.
+//
+static Bool     Harness_unprinted[HARNESS_NUM_SENSORS];
+
+//
+//	Faults (-e): a frame is cut short or gets a bit flipped with the
+//	given percentage, for the driver to retry.
+//
+static uint32_t Harness_errorPercent;
+static uint32_t Harness_faultSeed;
+static uint32_t Harness_cutShort;
+static uint32_t Harness_flipped;
+
+//
+//	Driver counters when the last request came, a polling driver
+//	still receives it after the stop.
+//
+static DHT11_Stats Harness_stats;
+
+//
+//	Called by the sensor model at every start pulse, for every
+//	sensor in turn. -n counts the requests.
+//
+static void Harness_frame(Wave_Frame* frame)
+{
+	uint8_t sensor = 0;
+
+	while (Harness_pins[sensor] != frame->pin) sensor++;
+
+	if ((sensor == 0) && (Harness_requests++ == Harness_numFrames))
+	{
+		Harness_done = TRUE;
+		DHT11_getStats(&Harness_stats);
+		Sim_stop();
+	}
+
+	if (Harness_done)
+	{
+		frame->numEdges = 0;
+		return;
+	}
+
+	Harness_humidity[sensor]    = HARNESS_HUMIDITY_MIN + (rand_r(&Harness_seed) % (HARNESS_HUMIDITY_MAX - HARNESS_HUMIDITY_MIN + 1));
+	Harness_temperature[sensor] = HARNESS_TEMPERATURE_MIN + (rand_r(&Harness_seed) % (HARNESS_TEMPERATURE_MAX - HARNESS_TEMPERATURE_MIN + 1));
+
+	Wave_setValues(frame, Harness_humidity[sensor], Harness_temperature[sensor]);
+	Harness_unprinted[sensor] = TRUE;
+
+	if (Harness_errorPercent && ((rand_r(&Harness_faultSeed) % 100) < Harness_errorPercent))
+	{
+		if (rand_r(&Harness_faultSeed) & 1)
+		{
+			frame->numEdges = 1 + (rand_r(&Harness_faultSeed) % (WAVE_NUM_EDGES - 1));
+			Harness_cutShort++;
+		}
+		else
+		{
+			frame->bytes[rand_r(&Harness_faultSeed) % (WAVE_NUM_BYTES - 1)] ^= 1 << (rand_r(&Harness_faultSeed) % 8);
+			Harness_flipped++;
+		}
+
+		Harness_unprinted[sensor] = FALSE;
+	}
+
+	Harness_sent++;
+}
+
+//
+//	A value printed with one decimal, in tenths.
+//
+static int32_t Harness_tenths(double value)
+{
+	return (int32_t)((value * 10) + ((value < 0) ? -0.5 : 0.5));
+}
+
+//
+//	Check what the firmware prints against what the sensor sent,
+//	the lines of DHT11_MULTI start with the sensor.
+//
+static void Harness_output(const char* str)
+{
+	double temperature = 0, humidity = 0;
+	unsigned int sensor = 0;
+	int skip = 0;
+
+	if (Harness_verbose) fputs(str, stdout);
+
+	//
+	//	The read of the unanswered last request doesn't count.
+	//
+	if (Harness_done) return;
+
+	if (sscanf(str, "sensor %u: %n", &sensor, &skip) == 1)
+	{
+		if (sensor >= HARNESS_NUM_SENSORS) Sim_fail("no such sensor");
+		str += skip;
+	}
+
+	Harness_unprinted[sensor] = FALSE;
+
+	if (sscanf(str, "temperature: %lf, humidity: %lf", &temperature, &humidity) == 2)
+	{
+		Harness_read++;
+		if ((Harness_tenths(temperature) != Harness_temperature[sensor]) ||
+		    (Harness_tenths(humidity) != Harness_humidity[sensor]))
+		{
+			Harness_wrong++;
+		}
+	}
+	else if (!strncmp(str, "DHT11_ERROR_TIMEOUT", strlen("DHT11_ERROR_TIMEOUT")))
+	{
+		Harness_timeouts++;
+	}
+	else if (!strncmp(str, "DHT11_ERROR_CHECKSUM", strlen("DHT11_ERROR_CHECKSUM")))
+	{
+		Harness_checksums++;
+	}
+}
+
+//
+//	A Hwi that polls the published sample, as an interrupt side
+//	consumer would. Every new sample must be newer than the last
+//	and carry the frame the sensor sent, the one before the first
+//	transaction has none.
+//
+#define HARNESS_PROBE_US				10000
+
+static Sim_Event Harness_probeEvent;
+static uint32_t  Harness_probed;
+static uint32_t  Harness_sequence;
+static uint32_t  Harness_timestamp;
+static uint32_t  Harness_stale;
+
+static void Harness_probe(UArg arg)
+{
+	DHT11_Sample sample;
+
+	if (!DHT11_getSample(&sample) && (sample.result != DHT11_NO_SAMPLE)) Sim_fail("sample before the first transaction");
+
+	if (sample.sequence != Harness_sequence)
+	{
+		if ((sample.sequence < Harness_sequence) || (sample.timestamp < Harness_timestamp)) Sim_fail("sample went back");
+
+		if ((sample.result == DHT11_OK) && !Harness_done &&
+		    ((sample.reading.temperature != Harness_temperature[0]) || (sample.reading.humidity != Harness_humidity[0])))
+		{
+			Harness_stale++;
+		}
+
+		Harness_sequence  = sample.sequence;
+		Harness_timestamp = sample.timestamp;
+		Harness_probed++;
+	}
+
+	Sim_schedule(&Harness_probeEvent, Sim_now() + Sim_fromMicros(HARNESS_PROBE_US));
+}
+
+//
+//	Clients of the sample cache besides the firmware's task (-c).
+//	Each asks again 1 ms to HARNESS_CLIENT_MAX_MS after its last
+//	answer, which must carry the last frame the sensor sent and be
+//	younger than the sensor interval. Only a client retrying its own
+//	transaction may wait through a retry pause, the others wait for
+//	at most the transaction running and one of their own.
+//
+#define HARNESS_MAX_CLIENTS			8
+#define HARNESS_CLIENT_MAX_MS		700
+#define HARNESS_MAX_WAIT_MS			(((2 * (DHT11_START_US + DHT11_FRAME_TIMEOUT_US)) / 1000) + 2)
+
+static Task_Struct Harness_clientTasks[HARNESS_MAX_CLIENTS];
+static uint32_t    Harness_numClients;
+static uint32_t    Harness_clientSeed;
+static uint32_t    Harness_answers;
+static uint32_t    Harness_maxAge;
+static uint32_t    Harness_maxWait;
+
+static void Harness_client(UArg arg0, UArg arg1)
+{
+	DHT11_Sample sample;
+	uint32_t     age = 0, asked = 0, wait = 0, sequence = 0;
+
+	while (1)
+	{
+		Task_sleep(((1 + (rand_r(&Harness_clientSeed) % HARNESS_CLIENT_MAX_MS)) * 1000) / Clock_tickPeriod);
+
+		sequence = DHT11_getSample(&sample);
+		asked    = Clock_getTicks();
+
+		DHT11_get(&sample, &age);
+		if (Harness_done) continue;
+
+		wait = ((Clock_getTicks() - asked) * Clock_tickPeriod) / 1000;
+
+		Harness_answers++;
+		if (age > Harness_maxAge) Harness_maxAge = age;
+		if (age >= HARNESS_INTERVAL_MS) Sim_fail("cached sample older than the sensor interval");
+
+		if (((sample.sequence - sequence) < 2) && (wait > Harness_maxWait)) Harness_maxWait = wait;
+		if (((sample.sequence - sequence) < 2) && (wait > HARNESS_MAX_WAIT_MS)) Sim_fail("client held up by a retry pause");
+
+		//
+		//	With faults, a request may fail every retry.
+		//
+		if (sample.result != DHT11_OK)
+		{
+			if (!Harness_errorPercent) Harness_wrong++;
+		}
+		else if ((sample.reading.temperature != Harness_temperature[0]) || (sample.reading.humidity != Harness_humidity[0]))
+		{
+			Harness_wrong++;
+		}
+	}
+}
+
+//
+//	Last CPU load report the firmware sent over the UART, and the
+//	last line of driver counters that follows it.
+//
+static char Harness_load[256];
+static char Harness_counters[256];
+
+static void Harness_uart(const char* line)
+{
+	if (Harness_verbose) printf("uart: %s\n", line);
+
+	if (!strncmp(line, "dht11:", strlen("dht11:")))
+	{
+		strncpy(Harness_counters, line, sizeof(Harness_counters) - 1);
+	}
+	else if (!strncmp(line, "load", strlen("load")))
+	{
+		strncpy(Harness_load, line, sizeof(Harness_load) - 1);
+	}
+}
+
+//
+//	The firmware's handlers take simulated time for their pin, timer
+//	and kernel calls, the last report must show a load, and well
+//	under HARNESS_MAX_LOAD (thousandths of a percent): a frame
+//	busy-waited every few seconds is the most they do.
+//
+#define HARNESS_MAX_LOAD				1000
+
+static Bool Harness_checkLoad(void)
+{
+	unsigned int whole = 0, thousandths = 0, load = 0;
+
+	if (!CPULOAD) return TRUE;
+
+	if (sscanf(Harness_load, "load %u.%u%%", &whole, &thousandths) != 2)
+	{
+		printf("FAIL: no CPU load report\n");
+		return FALSE;
+	}
+
+	load = (whole * 1000) + thousandths;
+	if (!load || (load > HARNESS_MAX_LOAD))
+	{
+		printf("FAIL: CPU load %u.%03u%% outside 0.001%% to %u.%03u%%\n", whole, thousandths,
+		       HARNESS_MAX_LOAD / 1000, HARNESS_MAX_LOAD % 1000);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+//
+//	The driver counted every frame the way it was sent, and retried
+//	every failure but the ones it gave up on.
+//
+static Bool Harness_checkCounters(void)
+{
+	const DHT11_Stats* stats = &Harness_stats;
+	unsigned int reported[6];
+	uint32_t faults = Harness_cutShort + Harness_flipped;
+	Bool ok = TRUE;
+
+	if (Harness_errorPercent) printf("faults: %u cut short, %u bit flipped\n", Harness_cutShort, Harness_flipped);
+
+	if ((stats->reads != (Harness_sent - faults)) || (stats->checksums != Harness_flipped) ||
+	    ((stats->timeouts[DHT11_PHASE_RESPONSE] + stats->timeouts[DHT11_PHASE_BIT_LOW] + stats->timeouts[DHT11_PHASE_BIT_HIGH]) != Harness_cutShort))
+	{
+		printf("FAIL: driver counted %u reads, %u checksum errors, %u/%u/%u timeouts\n", stats->reads, stats->checksums,
+		       stats->timeouts[DHT11_PHASE_RESPONSE], stats->timeouts[DHT11_PHASE_BIT_LOW], stats->timeouts[DHT11_PHASE_BIT_HIGH]);
+		ok = FALSE;
+	}
+
+	//
+	//	The clients' give-ups aren't printed.
+	//
+	if (!Harness_numClients && (stats->retries != (faults - (Harness_timeouts + Harness_checksums))))
+	{
+		printf("FAIL: driver counted %u retries\n", stats->retries);
+		ok = FALSE;
+	}
+
+	if (CPULOAD && (sscanf(Harness_counters, "dht11: reads %u, retries %u, checksum errors %u, timeouts response %u, bit low %u, bit high %u",
+	                       &reported[0], &reported[1], &reported[2], &reported[3], &reported[4], &reported[5]) != 6))
+	{
+		printf("FAIL: no driver counters report\n");
+		ok = FALSE;
+	}
+
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	Wave_Params waveParams;
+	const SimPower_Stats* power = NULL;
+	struct timespec start, end;
+	double seconds = 0;
+	Bool counted = TRUE, loaded = TRUE;
+	uint32_t unprinted = 0;
+	int option = 0;
+	uint8_t i = 0;
+
+	Wave_Params_init(&waveParams);
+	waveParams.format     = HARNESS_FORMAT;
+	waveParams.intervalMs = HARNESS_INTERVAL_MS;
+	waveParams.startMinUs = HARNESS_START_MIN_US;
+
+	while ((option = getopt(argc, argv, "n:s:j:r:c:e:v")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': Harness_numFrames    = strtoul(optarg, NULL, 0); break;
+			case 's': Harness_seed         = strtoul(optarg, NULL, 0); break;
+			case 'j': waveParams.jitterUs  = strtoul(optarg, NULL, 0); break;
+			case 'r': waveParams.riseUs    = strtoul(optarg, NULL, 0); break;
+			case 'c': Harness_numClients   = strtoul(optarg, NULL, 0); break;
+			case 'e': Harness_errorPercent = strtoul(optarg, NULL, 0); break;
+			case 'v': Harness_verbose      = TRUE;                     break;
+			default:
+				fprintf(stderr, "usage: %s [-n frames] [-s seed] [-j jitter us] [-r rise us] [-c clients] [-e error %%] [-v]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	//
+	//	The sensors of DHT11_MULTI don't go through the sample cache.
+	//
+	if ((Harness_numClients > HARNESS_MAX_CLIENTS) || (DHT11_MULTI && Harness_numClients))
+	{
+		fprintf(stderr, "%s: up to %u clients, no clients with DHT11_MULTI\n", argv[0], HARNESS_MAX_CLIENTS);
+		return EXIT_FAILURE;
+	}
+
+	//
+	//	Every sensor jitters its own way.
+	//
+	for (i = 0; i < HARNESS_NUM_SENSORS; i++)
+	{
+		waveParams.pin      = Harness_pins[i];
+		waveParams.frameFxn = Harness_frame;
+		waveParams.seed     = Harness_seed + i;
+		Wave_init(&waveParams);
+	}
+
+	Sim_setOutput(Harness_output);
+
+	//
+	//	The .cfg's Idle hook, and the UART the load reports come out of.
+	//	A profiling build asks for a dump while the first report goes
+	//	out, the two share the UART.
+	//
+	Sim_addIdleFunc(CpuLoad_idle);
+	SimUart_watch(Harness_uart);
+	if (PROFILE) SimUart_receive(Sim_fromMicros((CPULOAD_REPORT_MS + 1) * 1000), 'd');
+
+	//
+	//	The sensors of DHT11_MULTI don't go through the driver that
+	//	publishes samples.
+	//
+	Sim_Event_init(&Harness_probeEvent, Harness_probe, 0, SIM_LEVEL_HWI);
+	if (!DHT11_MULTI) Sim_schedule(&Harness_probeEvent, Sim_fromMicros(HARNESS_PROBE_US));
+
+	Harness_clientSeed = Harness_seed;
+	Harness_faultSeed  = Harness_seed;
+	for (i = 0; i < Harness_numClients; i++) Task_construct(&Harness_clientTasks[i], Harness_client, NULL, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	App_main();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+	power = SimPower_getStats();
+
+	printf("frames: %u, read: %u, wrong: %u, timeouts: %u, checksum errors: %u\n",
+	       Harness_sent, Harness_read, Harness_wrong, Harness_timeouts, Harness_checksums);
+	if (!DHT11_MULTI) printf("samples: %u seen by the Hwi probe, %u stale\n", Harness_probed, Harness_stale);
+	if (Harness_numClients) printf("clients: %u, answers: %u, max age: %u ms, max wait: %u ms\n",
+	                               Harness_numClients, Harness_answers, Harness_maxAge, Harness_maxWait);
+	printf("sensor: %u requests, %u sooner than %u ms after the last, longest start pulse %llu us\n",
+	       Wave_getStats()->frames, Wave_getStats()->early, HARNESS_INTERVAL_MS,
+	       (unsigned long long)Sim_toMicros(Wave_getStats()->longestStart));
+	printf("power: active %.2f%%, idle %.2f%%, standby %.2f%%, MCU %u uA\n",
+	       (100.0 * power->active) / Sim_now(), (100.0 * power->idle) / Sim_now(),
+	       (100.0 * power->standby) / Sim_now(), SimPower_getCurrent());
+	if (Harness_load[0]) printf("uart: %s\n", Harness_load);
+	if (Harness_counters[0]) printf("uart: %s\n", Harness_counters);
+	printf("simulated %.1f s in %.3f s, %.0f frames/s\n",
+	       Sim_toMicros(Sim_now()) / 1e6, seconds, Harness_sent / seconds);
+
+	//
+	//	What a byte received on the UART gets in a profiling build.
+	//
+	SimUart_watch(NULL);
+	Profile_dump();
+
+	if (!Harness_checkLoad()) loaded = FALSE;
+
+	if (!DHT11_MULTI && (Harness_probed < Harness_read)) printf("FAIL: the probe missed samples\n");
+
+	if (Wave_getStats()->early) printf("FAIL: the sensor was asked too early\n");
+
+	if (Sim_toMicros(Wave_getStats()->longestStart) > HARNESS_MAX_START_US) printf("FAIL: start pulse held past its clock\n");
+
+	if (Sim_toMicros(Sim_getLongestSwiMask()) > HARNESS_MAX_SWI_MASK_US)
+	{
+		printf("FAIL: Swis disabled for %llu us\n", (unsigned long long)Sim_toMicros(Sim_getLongestSwiMask()));
+	}
+
+	if (!Harness_checkCounters()) counted = FALSE;
+
+	for (i = 0; i < HARNESS_NUM_SENSORS; i++) unprinted += Harness_unprinted[i];
+
+	//
+	//	The firmware's task doesn't print the reads the clients ask
+	//	for, nor the faulty frames it retried.
+	//
+	return (Sim_failed() || Harness_wrong || !loaded || Harness_stale || Wave_getStats()->early ||
+	        (Sim_toMicros(Wave_getStats()->longestStart) > HARNESS_MAX_START_US) ||
+	        (Sim_toMicros(Sim_getLongestSwiMask()) > HARNESS_MAX_SWI_MASK_US) ||
+	        (Harness_numClients ? !Harness_read : (Harness_read != (Harness_sent - Harness_cutShort - Harness_flipped - unprinted))) ||
+	        (!DHT11_MULTI && (Harness_probed < Harness_read)) || !counted) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
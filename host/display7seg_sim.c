@@ -0,0 +1,323 @@
+//
+//	C Standard Libraries.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+//
+//	XDCtools Header files.
+//
+#include <xdc/std.h>
+//
+//	TI-RTOS Header files.
+//
+#include <ti/drivers/PIN.h>
+
+#include "Sim.h"
+#include "SimUart.h"
+#include "Recorder.h"
+#include "Segments.h"
+#include "Display.h"
+#include "CpuLoad.h"
+#include "Profile.h"
+
+//
+//	Board wiring of the display, as in display7seg/main.c, the segment
+//	pins come from its Segments.h.
+//
+#define DISPLAY_UNITS						PIN_ID(27)
+#define DISPLAY_TENS						PIN_ID(26)
+
+#define HARNESS_NUM_DIGITS			2
+#define HARNESS_MAX_GAP_US			((HARNESS_NUM_DIGITS + 1) * Display_getDwell())
+
+//
+//	The counter steps every 500 ms, sample half way through.
+//
+#define HARNESS_STEP_US					500000
+
+//
+//	Largest deviation of the measured duty from the brightness
+//	level's, in percent of it.
+//
+#define HARNESS_MAX_DUTY_ERROR	5
+
+//
+//	The firmware's main(), renamed by the build.
+//
+int App_main(void);
+
+static uint32_t  Harness_numSamples = 1000;
+static Bool      Harness_verbose;
+static Sim_Event Harness_sampleEvent;
+
+static uint32_t Harness_samples;
+static uint32_t Harness_wrong;
+
+//
+//	Per brightness level: time spent at it, time any digit was lit
+//	and lit segment time meanwhile. Only sample periods that start
+//	and end at the same level count.
+//
+static Sim_Time Harness_levelTime[DISPLAY_BRIGHTNESS_LEVELS];
+static Sim_Time Harness_levelOnTime[DISPLAY_BRIGHTNESS_LEVELS];
+static Sim_Time Harness_levelSegmentTime[DISPLAY_BRIGHTNESS_LEVELS];
+
+static uint8_t  Harness_lastLevel = DISPLAY_BRIGHTNESS_LEVELS;
+static Sim_Time Harness_lastTime;
+static Sim_Time Harness_lastOnTime;
+static Sim_Time Harness_lastSegmentTime;
+
+static void Harness_measure(void)
+{
+	const Recorder_Stats* stats = Recorder_getStats();
+	Sim_Time onTime = 0;
+	uint8_t  level  = Display_getBrightness();
+	uint8_t  i = 0;
+
+	for (i = 0; i < HARNESS_NUM_DIGITS; i++) onTime += stats->onTime[i];
+
+	if (level == Harness_lastLevel)
+	{
+		Harness_levelTime[level]        += Sim_now() - Harness_lastTime;
+		Harness_levelOnTime[level]      += onTime - Harness_lastOnTime;
+		Harness_levelSegmentTime[level] += stats->segmentTime - Harness_lastSegmentTime;
+	}
+
+	Harness_lastLevel       = level;
+	Harness_lastTime        = Sim_now();
+	Harness_lastOnTime      = onTime;
+	Harness_lastSegmentTime = stats->segmentTime;
+}
+
+//
+//	Measured duty and current of every brightness level against the
+//	driver's figures, FALSE when a duty is off.
+//
+static Bool Harness_report(void)
+{
+	double duty = 0, expected = 0, current = 0;
+	Bool   ok = TRUE;
+	uint8_t level = 0;
+
+	for (level = 0; level < DISPLAY_BRIGHTNESS_LEVELS; level++)
+	{
+		if (!Harness_levelTime[level]) continue;
+
+		duty     = (1000.0 * Harness_levelOnTime[level]) / Harness_levelTime[level];
+		expected = Display_getDuty(level);
+		current  = ((double)DISPLAY_SEGMENT_CURRENT_UA * Harness_levelSegmentTime[level]) / Harness_levelTime[level];
+
+		printf("brightness %u: duty %.1f/1000 (expected %.0f), %.0f uA shown, %u uA all segments\n",
+		       level, duty, expected, current, Display_getCurrent(level));
+
+		if ((100 * ((duty > expected) ? (duty - expected) : (expected - duty))) > (HARNESS_MAX_DUTY_ERROR * expected)) ok = FALSE;
+	}
+
+	return ok;
+}
+
+static void Harness_sample(UArg arg)
+{
+	int32_t expected = Harness_samples % 100;
+	int32_t value    = Recorder_getValue();
+
+	Harness_measure();
+
+	if (value != expected)
+	{
+		Harness_wrong++;
+		if (Harness_verbose) printf("sample %u: expected %d, display shows %d\n", Harness_samples, expected, value);
+	}
+
+	if (++Harness_samples == Harness_numSamples)
+	{
+		Sim_stop();
+		return;
+	}
+
+	Sim_schedule(&Harness_sampleEvent, Sim_now() + Sim_fromMicros(HARNESS_STEP_US));
+}
+
+//
+//	Last CPU load report the firmware sent over the UART, and the
+//	last line of refresh statistics that follows it.
+//
+static char Harness_load[256];
+static char Harness_refresh[256];
+
+static void Harness_uart(const char* line)
+{
+	if (Harness_verbose) printf("uart: %s\n", line);
+
+	if (!strncmp(line, "display:", strlen("display:")))
+	{
+		strncpy(Harness_refresh, line, sizeof(Harness_refresh) - 1);
+	}
+	else if (!strncmp(line, "load", strlen("load")))
+	{
+		strncpy(Harness_load, line, sizeof(Harness_load) - 1);
+	}
+}
+
+//
+//	The firmware's handlers take simulated time for their pin, timer
+//	and kernel calls, the last report must show a load, and well
+//	under HARNESS_MAX_LOAD (thousandths of a percent): a frame
+//	busy-waited every few seconds is the most they do.
+//
+#define HARNESS_MAX_LOAD				1000
+
+static Bool Harness_checkLoad(void)
+{
+	unsigned int whole = 0, thousandths = 0, load = 0;
+
+	if (!CPULOAD) return TRUE;
+
+	if (sscanf(Harness_load, "load %u.%u%%", &whole, &thousandths) != 2)
+	{
+		printf("FAIL: no CPU load report\n");
+		return FALSE;
+	}
+
+	load = (whole * 1000) + thousandths;
+	if (!load || (load > HARNESS_MAX_LOAD))
+	{
+		printf("FAIL: CPU load %u.%03u%% outside 0.001%% to %u.%03u%%\n", whole, thousandths,
+		       HARNESS_MAX_LOAD / 1000, HARNESS_MAX_LOAD % 1000);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+//
+//	The timer refresh pays the Hwi entry on every refresh and none
+//	waits much longer, the firmware's Hwi_disable() sections are
+//	short. Jitter can't exceed the spread of the latency.
+//
+#define HARNESS_MIN_LATENCY_NS	((SIM_COST_HWI_ENTRY * 1000) / SIM_TICKS_PER_US)
+#define HARNESS_MAX_LATENCY_NS	20000
+
+static Bool Harness_checkLatency(const Display_Stats* stats)
+{
+	unsigned int reported[5] = { 0 };
+	int expected = (DISPLAY_MODE == DISPLAY_MODE_TIMER) ? 5 : 1;
+	Bool ok = TRUE;
+
+	if ((DISPLAY_MODE == DISPLAY_MODE_TIMER) &&
+	    ((stats->minLatencyNs < HARNESS_MIN_LATENCY_NS) || (stats->maxLatencyNs > HARNESS_MAX_LATENCY_NS) ||
+	     (stats->meanLatencyNs < stats->minLatencyNs) || (stats->meanLatencyNs > stats->maxLatencyNs) ||
+	     (stats->maxJitterNs > (stats->maxLatencyNs - stats->minLatencyNs))))
+	{
+		printf("FAIL: refresh latency outside %u to %u ns\n", HARNESS_MIN_LATENCY_NS, HARNESS_MAX_LATENCY_NS);
+		ok = FALSE;
+	}
+
+	if (CPULOAD && (sscanf(Harness_refresh, "display: refreshes %u, latency min %u ns, mean %u ns, max %u ns, jitter %u ns",
+	                       &reported[0], &reported[1], &reported[2], &reported[3], &reported[4]) != expected))
+	{
+		printf("FAIL: no display refresh report\n");
+		ok = FALSE;
+	}
+	else if (CPULOAD && (DISPLAY_MODE == DISPLAY_MODE_TIMER) &&
+	         ((reported[1] < HARNESS_MIN_LATENCY_NS) || (reported[3] > HARNESS_MAX_LATENCY_NS)))
+	{
+		printf("FAIL: reported refresh latency outside %u to %u ns\n", HARNESS_MIN_LATENCY_NS, HARNESS_MAX_LATENCY_NS);
+		ok = FALSE;
+	}
+
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	Recorder_Params recorderParams;
+	const Recorder_Stats* stats = NULL;
+	Display_Stats displayStats;
+	struct timespec start, end;
+	double seconds = 0;
+	Bool   jittered = FALSE, dimmed = TRUE, timed = TRUE, loaded = TRUE;
+	int    option = 0;
+	uint8_t i = 0;
+
+	while ((option = getopt(argc, argv, "n:v")) != -1)
+	{
+		switch (option)
+		{
+			case 'n': Harness_numSamples = strtoul(optarg, NULL, 0); break;
+			case 'v': Harness_verbose    = TRUE;                     break;
+			default:
+				fprintf(stderr, "usage: %s [-n samples] [-v]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	Recorder_Params_init(&recorderParams);
+	recorderParams.segmentPins[0] = SEGMENT_A;
+	recorderParams.segmentPins[1] = SEGMENT_B;
+	recorderParams.segmentPins[2] = SEGMENT_C;
+	recorderParams.segmentPins[3] = SEGMENT_D;
+	recorderParams.segmentPins[4] = SEGMENT_E;
+	recorderParams.segmentPins[5] = SEGMENT_F;
+	recorderParams.segmentPins[6] = SEGMENT_G;
+	recorderParams.digitPins[0]   = DISPLAY_TENS;
+	recorderParams.digitPins[1]   = DISPLAY_UNITS;
+	recorderParams.numDigits      = HARNESS_NUM_DIGITS;
+	Recorder_init(&recorderParams);
+
+	Sim_Event_init(&Harness_sampleEvent, Harness_sample, 0, SIM_LEVEL_EXT);
+	Sim_schedule(&Harness_sampleEvent, Sim_fromMicros(HARNESS_STEP_US / 2));
+
+	//
+	//	The .cfg's Idle hook, and the UART the load reports come out of.
+	//	A profiling build asks for a dump while the first report goes
+	//	out, the two share the UART.
+	//
+	Sim_addIdleFunc(CpuLoad_idle);
+	SimUart_watch(Harness_uart);
+	if (PROFILE) SimUart_receive(Sim_fromMicros((CPULOAD_REPORT_MS + 1) * 1000), 'd');
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	App_main();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+	stats = Recorder_getStats();
+
+	printf("samples: %u, wrong: %u\n", Harness_samples, Harness_wrong);
+	printf("display: %u writes, %u glitches, worst refresh gap tens %llu us, units %llu us\n",
+	       stats->writes, stats->glitches,
+	       (unsigned long long)Sim_toMicros(stats->maxGap[0]), (unsigned long long)Sim_toMicros(stats->maxGap[1]));
+	dimmed = Harness_report();
+	Display_getStats(&displayStats);
+	printf("refresh: %u, latency min %u ns, mean %u ns, max %u ns, jitter %u ns\n",
+	       displayStats.refreshes, displayStats.minLatencyNs, displayStats.meanLatencyNs,
+	       displayStats.maxLatencyNs, displayStats.maxJitterNs);
+	if (Harness_load[0]) printf("uart: %s\n", Harness_load);
+	if (Harness_refresh[0]) printf("uart: %s\n", Harness_refresh);
+	printf("simulated %.1f s in %.3f s\n", Sim_toMicros(Sim_now()) / 1e6, seconds);
+
+	//
+	//	What a byte received on the UART gets in a profiling build.
+	//
+	SimUart_watch(NULL);
+	Profile_dump();
+
+	for (i = 0; i < HARNESS_NUM_DIGITS; i++)
+	{
+		if (Sim_toMicros(stats->maxGap[i]) >= HARNESS_MAX_GAP_US) jittered = TRUE;
+	}
+
+	if (jittered) printf("FAIL: display refresh held for a dwell or more\n");
+	if (stats->glitches) printf("FAIL: torn display frames\n");
+	if (!dimmed) printf("FAIL: brightness duty off by more than %d%%\n", HARNESS_MAX_DUTY_ERROR);
+	if (!Harness_checkLoad()) loaded = FALSE;
+	if (!Harness_checkLatency(&displayStats)) timed = FALSE;
+
+	return (Sim_failed() || Harness_wrong || jittered || stats->glitches || !dimmed || !loaded ||
+	        !timed) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+//
+//	Host stand-in for the board file, the GPTimer halves keep the
+//	CC2650_LAUNCHXL indexes.
+//
+#define Board_GPTIMER0A					0
+#define Board_GPTIMER0B					1
+#define Board_GPTIMER1A					2
+#define Board_GPTIMER1B					3
+#define Board_GPTIMER2A					4
+#define Board_GPTIMER2B					5
+#define Board_GPTIMER3A					6
+#define Board_GPTIMER3B					7
+
+#define Board_UART0							0
+
+#define Board_initUART()				UART_init()
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef __DRIVERLIB_AON_RTC_H__
+#define __DRIVERLIB_AON_RTC_H__
+
+//
+//	Host stand-in for the AON RTC, only the time read. The compare
+//	value is the middle 32 bits of the 64 bit RTC: 16 bits of
+//	seconds and 16 of fraction, stepping every 1/32768 s.
+//
+#include <stdint.h>
+
+uint32_t AONRTCCurrentCompareValueGet(void);
+
+#endif
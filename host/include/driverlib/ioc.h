@@ -0,0 +1,18 @@
+#ifndef __DRIVERLIB_IOC_H__
+#define __DRIVERLIB_IOC_H__
+
+//
+//	Host stand-in for the IOC port ids a pin can be muxed to, only
+//	the GPIO and the GPTimer outputs are simulated.
+//
+#define IOC_PORT_GPIO						0x00000000
+#define IOC_PORT_MCU_PORT_EVENT0	0x00000017
+#define IOC_PORT_MCU_PORT_EVENT1	0x00000018
+#define IOC_PORT_MCU_PORT_EVENT2	0x00000019
+#define IOC_PORT_MCU_PORT_EVENT3	0x0000001A
+#define IOC_PORT_MCU_PORT_EVENT4	0x0000001B
+#define IOC_PORT_MCU_PORT_EVENT5	0x0000001C
+#define IOC_PORT_MCU_PORT_EVENT6	0x0000001D
+#define IOC_PORT_MCU_PORT_EVENT7	0x0000001E
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __TI_DRIVERS_PIN_H__
+#define __TI_DRIVERS_PIN_H__
+
+//
+//	Host stand-in for the PIN driver. The pin ids and the
+//	configuration flags keep their TI-RTOS names, the bit layout
+//	of the flags is private to the host build.
+//
+#include <stdint.h>
+#include <xdc/std.h>
+
+typedef uint32_t PIN_Config;
+typedef uint8_t  PIN_Id;
+
+typedef enum PIN_Status
+{
+	PIN_SUCCESS           = 0,
+	PIN_ALREADY_ALLOCATED = 1,
+	PIN_NO_ACCESS         = 2,
+	PIN_UNSUPPORTED       = 3
+} PIN_Status;
+
+#define PIN_ID(x)								((x) & 0xFF)
+#define PIN_UNASSIGNED					0xFF
+#define PIN_TERMINATE						0xFE
+
+#define PIN_GPIO_OUTPUT_DIS			0
+#define PIN_GPIO_OUTPUT_EN			(1 << 8)
+#define PIN_GPIO_LOW						0
+#define PIN_GPIO_HIGH						(1 << 9)
+#define PIN_PUSHPULL						0
+#define PIN_OPENDRAIN						(1 << 10)
+#define PIN_OPENSOURCE					(1 << 11)
+#define PIN_SLEWCTRL						(1 << 12)
+#define PIN_DRVSTR_MIN					(1 << 13)
+#define PIN_DRVSTR_MED					(2 << 13)
+#define PIN_DRVSTR_MAX					(3 << 13)
+#define PIN_INPUT_EN						0
+#define PIN_INPUT_DIS						(1 << 15)
+#define PIN_HYSTERESIS					(1 << 16)
+#define PIN_NOPULL							0
+#define PIN_PULLUP							(1 << 17)
+#define PIN_PULLDOWN						(2 << 17)
+#define PIN_IRQ_DIS							0
+#define PIN_IRQ_NEGEDGE					(1 << 19)
+#define PIN_IRQ_POSEDGE					(2 << 19)
+#define PIN_IRQ_BOTHEDGES				(3 << 19)
+
+#define PIN_BM_GPIO_OUTPUT_EN		PIN_GPIO_OUTPUT_EN
+#define PIN_BM_GPIO_OUTPUT_VAL	PIN_GPIO_HIGH
+#define PIN_BM_OUTPUT_MODE			(PIN_OPENDRAIN | PIN_OPENSOURCE)
+#define PIN_BM_INPUT_EN					PIN_INPUT_DIS
+#define PIN_BM_PULLING					(3 << 17)
+#define PIN_BM_IRQ							(3 << 19)
+
+typedef struct PIN_State_s PIN_State;
+typedef PIN_State*         PIN_Handle;
+
+typedef void (*PIN_IntCb)(PIN_Handle handle, PIN_Id pinId);
+
+struct PIN_State_s
+{
+	uint32_t  portMask;
+	PIN_IntCb callbackFxn;
+	UArg      userArg;
+};
+
+PIN_Status    PIN_init(const PIN_Config pinConfig[]);
+PIN_Handle    PIN_open(PIN_State* state, const PIN_Config pinList[]);
+void          PIN_close(PIN_Handle handle);
+PIN_Status    PIN_setConfig(PIN_Handle handle, PIN_Config updateMask, PIN_Config pinCfg);
+PIN_Status    PIN_setOutputValue(PIN_Handle handle, PIN_Id pinId, uint_fast8_t val);
+uint_fast8_t  PIN_getOutputValue(PIN_Id pinId);
+uint_fast8_t  PIN_getInputValue(PIN_Id pinId);
+PIN_Status    PIN_setPortOutputValue(PIN_Handle handle, uint_fast32_t outputValueMask);
+uint_fast32_t PIN_getPortOutputValue(PIN_Handle handle);
+uint_fast32_t PIN_getPortInputValue(PIN_Handle handle);
+uint_fast32_t PIN_getPortMask(PIN_Handle handle);
+PIN_Status    PIN_registerIntCb(PIN_Handle handle, PIN_IntCb callbackFxn);
+PIN_Status    PIN_setInterrupt(PIN_Handle handle, PIN_Config pinCfg);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef __TI_DRIVERS_POWER_H__
+#define __TI_DRIVERS_POWER_H__
+
+//
+//	Host stand-in for the Power driver, constraints only. The
+//	simulator's idle loop honours them (SimPower.h).
+//
+#include <stdint.h>
+
+#define Power_SUCCESS						0
+#define Power_EFAIL							(-1)
+
+void          Power_init(void);
+int_fast16_t  Power_setConstraint(uint_fast16_t constraintId);
+int_fast16_t  Power_releaseConstraint(uint_fast16_t constraintId);
+uint_fast32_t Power_getConstraintMask(void);
+
+#endif
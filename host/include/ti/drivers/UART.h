@@ -0,0 +1,50 @@
+#ifndef __TI_DRIVERS_UART_H__
+#define __TI_DRIVERS_UART_H__
+
+//
+//	Host stand-in for the UART driver, blocking mode only. The
+//	bytes go to the simulator's UART (SimUart.h).
+//
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct UART_Config* UART_Handle;
+
+#define UART_ERROR							(-1)
+
+typedef enum UART_Mode
+{
+	UART_MODE_BLOCKING,
+	UART_MODE_CALLBACK
+} UART_Mode;
+
+typedef enum UART_DataMode
+{
+	UART_DATA_BINARY,
+	UART_DATA_TEXT
+} UART_DataMode;
+
+typedef enum UART_Echo
+{
+	UART_ECHO_OFF,
+	UART_ECHO_ON
+} UART_Echo;
+
+typedef struct UART_Params
+{
+	UART_Mode     readMode;
+	UART_Mode     writeMode;
+	UART_DataMode readDataMode;
+	UART_DataMode writeDataMode;
+	UART_Echo     readEcho;
+	uint32_t      baudRate;
+} UART_Params;
+
+void        UART_init(void);
+void        UART_Params_init(UART_Params* params);
+UART_Handle UART_open(unsigned int index, UART_Params* params);
+void        UART_close(UART_Handle handle);
+int         UART_read(UART_Handle handle, void* buffer, size_t size);
+int         UART_write(UART_Handle handle, const void* buffer, size_t size);
+
+#endif
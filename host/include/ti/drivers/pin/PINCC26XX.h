@@ -0,0 +1,18 @@
+#ifndef __TI_DRIVERS_PIN_PINCC26XX_H__
+#define __TI_DRIVERS_PIN_PINCC26XX_H__
+
+//
+//	Host stand-in for the CC26XX PIN driver extensions.
+//
+#include <stdint.h>
+
+#include <ti/drivers/PIN.h>
+
+//
+//	Route a pin to a peripheral port (driverlib/ioc.h), IOC_PORT_GPIO
+//	hands it back to the output register.
+//
+PIN_Status PINCC26XX_setMux(PIN_Handle handle, PIN_Id pinId, int32_t nMux);
+int32_t    PINCC26XX_getMux(PIN_Id pinId);
+
+#endif
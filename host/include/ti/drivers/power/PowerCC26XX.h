@@ -0,0 +1,15 @@
+#ifndef __TI_DRIVERS_POWER_POWERCC26XX_H__
+#define __TI_DRIVERS_POWER_POWERCC26XX_H__
+
+//
+//	Host stand-in for the CC26XX power constraints.
+//
+#include <ti/drivers/Power.h>
+
+#define PowerCC26XX_SD_DISALLOW					1
+#define PowerCC26XX_SB_DISALLOW					2
+#define PowerCC26XX_IDLE_PD_DISALLOW		3
+
+#define PowerCC26XX_NUMCONSTRAINTS			8
+
+#endif
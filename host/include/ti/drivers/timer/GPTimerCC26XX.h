@@ -0,0 +1,87 @@
+#ifndef __TI_DRIVERS_TIMER_GPTIMERCC26XX_H__
+#define __TI_DRIVERS_TIMER_GPTIMERCC26XX_H__
+
+//
+//	Host stand-in for the GPTimer driver. Only the periodic and PWM
+//	modes are simulated, the handle is opaque and the register
+//	level access of the capture and uDMA code has no host build.
+//
+#include <stdint.h>
+#include <xdc/std.h>
+
+#include <driverlib/ioc.h>
+
+typedef struct GPTimerCC26XX_Object* GPTimerCC26XX_Handle;
+
+typedef uint32_t GPTimerCC26XX_Value;
+
+typedef enum GPTimerCC26XX_Width
+{
+	GPT_CONFIG_32BIT = 0,
+	GPT_CONFIG_16BIT = 1
+} GPTimerCC26XX_Width;
+
+typedef enum GPTimerCC26XX_Mode
+{
+	GPT_MODE_ONESHOT_UP    = 0,
+	GPT_MODE_PERIODIC_UP   = 1,
+	GPT_MODE_EDGE_COUNT_UP = 2,
+	GPT_MODE_EDGE_TIME_UP  = 3,
+	GPT_MODE_PWM           = 4
+} GPTimerCC26XX_Mode;
+
+typedef enum GPTimerCC26XX_DebugMode
+{
+	GPTimerCC26XX_DEBUG_STALL_OFF = 0,
+	GPTimerCC26XX_DEBUG_STALL_ON  = 1
+} GPTimerCC26XX_DebugMode;
+
+typedef enum GPTimerCC26XX_Interrupt
+{
+	GPT_INT_TIMEOUT       = 1 << 0,
+	GPT_INT_CAPTURE_MATCH = 1 << 1,
+	GPT_INT_CAPTURE       = 1 << 2,
+	GPT_INT_MATCH         = 1 << 3
+} GPTimerCC26XX_Interrupt;
+
+typedef uint16_t GPTimerCC26XX_IntMask;
+
+//
+//	Port events the timer halves drive, for PINCC26XX_setMux().
+//
+typedef enum GPTimerCC26XX_PinMux
+{
+	GPT_PIN_0A = IOC_PORT_MCU_PORT_EVENT0,
+	GPT_PIN_0B = IOC_PORT_MCU_PORT_EVENT1,
+	GPT_PIN_1A = IOC_PORT_MCU_PORT_EVENT2,
+	GPT_PIN_1B = IOC_PORT_MCU_PORT_EVENT3,
+	GPT_PIN_2A = IOC_PORT_MCU_PORT_EVENT4,
+	GPT_PIN_2B = IOC_PORT_MCU_PORT_EVENT5,
+	GPT_PIN_3A = IOC_PORT_MCU_PORT_EVENT6,
+	GPT_PIN_3B = IOC_PORT_MCU_PORT_EVENT7
+} GPTimerCC26XX_PinMux;
+
+typedef struct GPTimerCC26XX_Params
+{
+	GPTimerCC26XX_Width     width;
+	GPTimerCC26XX_Mode      mode;
+	GPTimerCC26XX_DebugMode debugStallMode;
+} GPTimerCC26XX_Params;
+
+typedef void (*GPTimerCC26XX_HwiFxn)(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask interruptMask);
+
+void                 GPTimerCC26XX_Params_init(GPTimerCC26XX_Params* params);
+GPTimerCC26XX_Handle GPTimerCC26XX_open(unsigned int index, const GPTimerCC26XX_Params* params);
+void                 GPTimerCC26XX_close(GPTimerCC26XX_Handle handle);
+void                 GPTimerCC26XX_start(GPTimerCC26XX_Handle handle);
+void                 GPTimerCC26XX_stop(GPTimerCC26XX_Handle handle);
+void                 GPTimerCC26XX_setLoadValue(GPTimerCC26XX_Handle handle, GPTimerCC26XX_Value loadValue);
+void                 GPTimerCC26XX_setMatchValue(GPTimerCC26XX_Handle handle, GPTimerCC26XX_Value matchValue);
+GPTimerCC26XX_Value  GPTimerCC26XX_getFreeRunValue(GPTimerCC26XX_Handle handle);
+void                 GPTimerCC26XX_registerInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_HwiFxn callback, GPTimerCC26XX_IntMask intMask);
+void                 GPTimerCC26XX_unregisterInterrupt(GPTimerCC26XX_Handle handle);
+void                 GPTimerCC26XX_enableInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask intMask);
+void                 GPTimerCC26XX_disableInterrupt(GPTimerCC26XX_Handle handle, GPTimerCC26XX_IntMask intMask);
+GPTimerCC26XX_PinMux GPTimerCC26XX_getPinMux(GPTimerCC26XX_Handle handle);
+
+#endif
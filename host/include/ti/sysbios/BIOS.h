@@ -0,0 +1,15 @@
+#ifndef __TI_SYSBIOS_BIOS_H__
+#define __TI_SYSBIOS_BIOS_H__
+
+//
+//	Host stand-in for SYS/BIOS. BIOS_start() runs the simulated
+//	scheduler and returns once the harness stops the simulation.
+//
+#include <xdc/std.h>
+
+#define BIOS_WAIT_FOREVER				(~(UInt32)0)
+#define BIOS_NO_WAIT						0
+
+void BIOS_start(void);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef __TI_SYSBIOS_HAL_HWI_H__
+#define __TI_SYSBIOS_HAL_HWI_H__
+
+//
+//	Host stand-in for the Hwi module, only global masking.
+//
+#include <xdc/std.h>
+
+UInt Hwi_disable(void);
+void Hwi_restore(UInt key);
+
+#endif
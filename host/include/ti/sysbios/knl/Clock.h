@@ -0,0 +1,50 @@
+#ifndef __TI_SYSBIOS_KNL_CLOCK_H__
+#define __TI_SYSBIOS_KNL_CLOCK_H__
+
+//
+//	Host stand-in for the Clock module. Timeouts are kept as
+//	simulated time events, nothing runs on ticks without a clock.
+//
+#include <xdc/std.h>
+
+typedef void (*Clock_FuncPtr)(UArg);
+
+typedef struct Clock_Params
+{
+	UInt32 period;
+	Bool   startFlag;
+	UArg   arg;
+} Clock_Params;
+
+typedef struct Clock_Struct
+{
+	Clock_FuncPtr        fxn;
+	UArg                 arg;
+	UInt32               timeout;
+	UInt32               period;
+	uint64_t             when;
+	Bool                 active;
+	struct Clock_Struct* next;
+} Clock_Struct;
+
+typedef Clock_Struct* Clock_Handle;
+
+//
+//	Tick period in microseconds, matches Clock.tickPeriod in the
+//	project .cfg unless overridden with -DSIM_TICK_PERIOD.
+//
+extern const UInt32 Clock_tickPeriod;
+
+void   Clock_Params_init(Clock_Params* params);
+void   Clock_construct(Clock_Struct* obj, Clock_FuncPtr fxn, UInt timeout, const Clock_Params* params);
+void   Clock_destruct(Clock_Struct* obj);
+void   Clock_start(Clock_Handle handle);
+void   Clock_stop(Clock_Handle handle);
+void   Clock_setTimeout(Clock_Handle handle, UInt32 timeout);
+void   Clock_setPeriod(Clock_Handle handle, UInt32 period);
+Bool   Clock_isActive(Clock_Handle handle);
+UInt32 Clock_getTicks(void);
+
+#define Clock_handle(obj)				((Clock_Handle)(obj))
+
+#endif
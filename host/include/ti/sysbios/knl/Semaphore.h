@@ -0,0 +1,39 @@
+#ifndef __TI_SYSBIOS_KNL_SEMAPHORE_H__
+#define __TI_SYSBIOS_KNL_SEMAPHORE_H__
+
+//
+//	Host stand-in for the Semaphore module.
+//
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Task.h>
+
+typedef enum Semaphore_Mode
+{
+	Semaphore_Mode_COUNTING,
+	Semaphore_Mode_BINARY
+} Semaphore_Mode;
+
+typedef struct Semaphore_Params
+{
+	Semaphore_Mode mode;
+} Semaphore_Params;
+
+typedef struct Semaphore_Struct
+{
+	Semaphore_Mode mode;
+	UInt           count;
+	Task_Handle    pending;
+} Semaphore_Struct;
+
+typedef Semaphore_Struct* Semaphore_Handle;
+
+void Semaphore_Params_init(Semaphore_Params* params);
+void Semaphore_construct(Semaphore_Struct* obj, Int count, const Semaphore_Params* params);
+Bool Semaphore_pend(Semaphore_Handle handle, UInt32 timeout);
+void Semaphore_post(Semaphore_Handle handle);
+void Semaphore_reset(Semaphore_Handle handle, Int count);
+Int  Semaphore_getCount(Semaphore_Handle handle);
+
+#define Semaphore_handle(obj)		((Semaphore_Handle)(obj))
+
+#endif
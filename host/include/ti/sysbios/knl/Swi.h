@@ -0,0 +1,13 @@
+#ifndef __TI_SYSBIOS_KNL_SWI_H__
+#define __TI_SYSBIOS_KNL_SWI_H__
+
+//
+//	Host stand-in for the Swi module, only global masking. Clock
+//	and PIN callbacks run as simulated Swis.
+//
+#include <xdc/std.h>
+
+UInt Swi_disable(void);
+void Swi_restore(UInt key);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __TI_SYSBIOS_KNL_TASK_H__
+#define __TI_SYSBIOS_KNL_TASK_H__
+
+//
+//	Host stand-in for the Task module. Tasks run on their own host
+//	stack and are switched cooperatively, at every blocking call and
+//	whenever they poll the simulated hardware.
+//
+#include <xdc/std.h>
+
+typedef void (*Task_FuncPtr)(UArg, UArg);
+
+typedef struct Task_Params
+{
+	UArg   arg0;
+	UArg   arg1;
+	Int    priority;
+	Ptr    stack;
+	size_t stackSize;
+} Task_Params;
+
+typedef struct Task_Struct
+{
+	Task_FuncPtr        fxn;
+	UArg                arg0;
+	UArg                arg1;
+	Int                 priority;
+	Int                 mode;
+	Bool                timedOut;
+	void*               context;
+	void*               stack;
+	struct Task_Struct* next;
+	struct Task_Struct* waitNext;
+} Task_Struct;
+
+typedef Task_Struct* Task_Handle;
+
+void Task_Params_init(Task_Params* params);
+void Task_construct(Task_Struct* obj, Task_FuncPtr fxn, const Task_Params* params, void* eb);
+void Task_sleep(UInt32 ticks);
+void Task_yield(void);
+Task_Handle Task_self(void);
+
+//
+//	Priorities run from 0 (idle) to Task_numPriorities - 1, set in
+//	the .cfg. A lower priority takes effect at the next switch.
+//
+extern const Int Task_numPriorities;
+
+Int Task_setPri(Task_Handle handle, Int newpri);
+
+#define Task_handle(obj)				((Task_Handle)(obj))
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef __XDC_RUNTIME_SYSTEM_H__
+#define __XDC_RUNTIME_SYSTEM_H__
+
+//
+//	Host stand-in for xdc.runtime.System, output goes to stdout
+//	unless a harness installs its own sink with Sim_setOutput().
+//
+#include <xdc/std.h>
+
+void System_abort(const char* str);
+Int  System_printf(const char* fmt, ...);
+Int  System_sprintf(Char* buf, const char* fmt, ...);
+void System_flush(void);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef __XDC_STD_H__
+#define __XDC_STD_H__
+
+//
+//	Host stand-in for the XDCtools base types.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+typedef char            Char;
+typedef unsigned char   UChar;
+typedef short           Short;
+typedef unsigned short  UShort;
+typedef int             Int;
+typedef unsigned int    UInt;
+typedef long            Long;
+typedef unsigned long   ULong;
+typedef int8_t          Int8;
+typedef uint8_t         UInt8;
+typedef int16_t         Int16;
+typedef uint16_t        UInt16;
+typedef int32_t         Int32;
+typedef uint32_t        UInt32;
+typedef uint64_t        UInt64;
+typedef unsigned short  Bool;
+typedef void*           Ptr;
+typedef const char*     String;
+typedef uintptr_t       UArg;
+typedef int32_t         Bits32;
+typedef void            Void;
+
+#ifndef TRUE
+#define TRUE            1
+#endif
+#ifndef FALSE
+#define FALSE           0
+#endif
+#ifndef NULL
+#define NULL            ((void*)0)
+#endif
+
+#endif